@@ -58,9 +58,10 @@ struct __is_boost_multiprecision_number_impl
     : public std::false_type
 { };
 
-template <typename... _Args>
+template <typename _Backend,
+          boost::multiprecision::expression_template_option _Et>
 struct __is_boost_multiprecision_number_impl<
-    boost::multiprecision::number<_Args...> > 
+    boost::multiprecision::number<_Backend, _Et> > 
     : public std::true_type
 { };
 
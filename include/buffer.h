@@ -4,6 +4,9 @@
 #include "byte.h"
 #include "byte_view.h"
 #include "type_traits.h"
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <concepts>
 #include <ranges>
 
@@ -15,6 +18,31 @@ namespace __detail {
 	template <typename _Tp, typename _Up>
 	concept __different_from
     	= !std::same_as<std::remove_cvref_t<_Tp>, std::remove_cvref_t<_Up> >;
+
+	template <typename _Tp>
+	concept __resizable_for_overwrite = requires (_Tp &__t, std::size_t __n)
+	{ __t.resize_for_overwrite (__n); };
+
+	// Grows __t to __n bytes that the caller is about to overwrite.
+	// Containers with resize_for_overwrite skip initializing them; others
+	// are resized, after reserving geometrically so that repeated prepares
+	// stay amortized O(1) whatever their resize does.  Zeroing is avoided
+	// for vectors too when they use default_init_allocator.
+	template <typename _Tp>
+	constexpr void
+	__resize_for_overwrite (_Tp &__t, std::size_t __n)
+	{
+		if constexpr (__resizable_for_overwrite<_Tp>)
+			__t.resize_for_overwrite (__n);
+		else
+		{
+			if constexpr (requires { __t.reserve (__n); })
+				if (__n > __t.capacity ())
+					__t.reserve (std::min (std::max (__n, 2 * __t.capacity ()),
+						__t.max_size ()));
+			__t.resize (__n);
+		}
+	}
 }
 
 template <typename _Tp>
@@ -35,11 +63,11 @@ class basic_buffer_adaptor
 	static void _S_test (_Tp &&) = delete;
 
 public:
-	template <__detail::__different_from<default_basic_buffer_adaptor> _Up>
+	template <__detail::__different_from<basic_buffer_adaptor> _Up>
 	requires std::convertible_to<_Up, _Tp &> 
 		&& requires { _S_test (std::declval<_Up> ()); }
 	constexpr explicit
-	default_basic_buffer_adaptor (_Up &&__t)
+	basic_buffer_adaptor (_Up &&__t)
 	noexcept (noexcept (static_cast<_Tp &> (std::declval<_Up> ())))
 	: _M_uptr (std::addressof(static_cast<_Tp &> (std::forward<_Up> (__t)))),
 		_M_size (std::ranges::size(__t))
@@ -55,7 +83,7 @@ public:
 
 	constexpr auto
 	data () const noexcept
-	{ return as_byte_view(*_M_uptr); }
+	{ return as_byte_view (*_M_uptr).subview (0, _M_size); }
 
 	constexpr auto
 	empty () const noexcept
@@ -71,11 +99,11 @@ public:
 
 	constexpr auto
 	end () noexcept
-	{ return std::ranges::end (*_M_uptr); }
+	{ return std::ranges::begin (*_M_uptr) + _M_size; }
 
 	constexpr auto
 	end () const noexcept
-	{ return std::ranges::end (*_M_uptr); }
+	{ return std::ranges::begin (*_M_uptr) + _M_size; }
 
 	constexpr auto
 	max_size () const noexcept
@@ -89,7 +117,7 @@ public:
 	prepare (std::size_t __n) 
 	{
 		__glibcxx_assert (_M_size + __n <= max_size ());
-		_M_uptr->resize (_M_size + __n);
+		__detail::__resize_for_overwrite (*_M_uptr, _M_size + __n);
 		return as_byte_view (*_M_uptr).subview(_M_size, __n);
 	}
 
@@ -114,12 +142,137 @@ private:
 	std::size_t _M_size;
 };
 
+// Uses all of the underlying container as a circular region whose size is
+// kept a power of two, so consume only moves the read position and never
+// shifts the remaining bytes.  The readable bytes and the space handed out
+// by prepare may wrap around the end of the region, hence data and prepare
+// return two views, the second one empty unless they wrap.  The region only
+// moves when prepare needs more room than is free.
 template <basic_buffer_underlying _Tp>
+class basic_ring_buffer_adaptor
+{
+	static void _S_test (_Tp &);
+	static void _S_test (_Tp &&) = delete;
+
+	static constexpr std::size_t _S_min_capacity = 64;
+
+public:
+	using view_type = decltype (as_byte_view (std::declval<_Tp &> ()));
+	using const_view_type = byte_view;
+	using buffers_type = std::array<view_type, 2>;
+	using const_buffers_type = std::array<const_view_type, 2>;
+
+	// The current contents of __t become the readable bytes.
+	template <__detail::__different_from<basic_ring_buffer_adaptor> _Up>
+	requires std::convertible_to<_Up, _Tp &> 
+		&& requires { _S_test (std::declval<_Up> ()); }
+	constexpr explicit
+	basic_ring_buffer_adaptor (_Up &&__t)
+	: _M_uptr (std::addressof(static_cast<_Tp &> (std::forward<_Up> (__t)))),
+		_M_head (0), _M_size (std::ranges::size (*_M_uptr)), _M_prepared (0)
+	{
+		__detail::__resize_for_overwrite (*_M_uptr,
+			std::bit_ceil (std::max (_M_size, _S_min_capacity)));
+	}
+
+	constexpr decltype(auto)
+	base () const noexcept
+	{ return *_M_uptr; }
+
+	constexpr auto
+	size () const noexcept
+	{ return _M_size; }
+
+	constexpr auto
+	empty () const noexcept
+	{ return _M_size == 0; }
+
+	// The size of the circular region.
+	constexpr auto
+	capacity () const noexcept
+	{ return std::ranges::size (*_M_uptr); }
+
+	constexpr auto
+	max_size () const noexcept
+	{ return _M_uptr->max_size (); }
+
+	constexpr buffers_type
+	data () noexcept
+	{ return _M_segments<view_type> (_M_head, _M_size); }
+
+	constexpr const_buffers_type
+	data () const noexcept
+	{ return _M_segments<const_view_type> (_M_head, _M_size); }
+
+	// Exactly __n writable bytes following the readable ones; a later
+	// prepare or consume invalidates them.
+	constexpr buffers_type
+	prepare (std::size_t __n)
+	{
+		__glibcxx_assert (_M_size + __n <= max_size ());
+		if (capacity () - _M_size < __n)
+			_M_grow (_M_size + __n);
+		_M_prepared = __n;
+		return _M_segments<view_type> (_M_head + _M_size, __n);
+	}
+
+	constexpr void
+	commit (std::size_t __n) noexcept
+	{
+		_M_size += std::min (__n, _M_prepared);
+		_M_prepared = 0;
+	}
+
+	constexpr void
+	consume (std::size_t __n) noexcept
+	{
+		std::size_t __m = std::min (__n, _M_size);
+		_M_size -= __m;
+		// Once drained, restart at the front so that small messages stay
+		// contiguous.
+		_M_head = _M_size == 0 ? 0 : (_M_head + __m) & (capacity () - 1);
+	}
+
+private:
+	template <typename _View>
+	constexpr std::array<_View, 2>
+	_M_segments (std::size_t __pos, std::size_t __n) const noexcept
+	{
+		std::size_t __cap = capacity ();
+		__pos &= __cap - 1;
+		std::size_t __first = std::min (__n, __cap - __pos);
+		_View __region (std::ranges::data (*_M_uptr), __cap);
+		return { __region.subview (__pos, __first),
+				 __region.subview (0, __n - __first) };
+	}
+
+	// Moves the readable bytes to the front, then enlarges the region to
+	// the next power of two holding at least __n bytes.
+	constexpr void
+	_M_grow (std::size_t __n)
+	{
+		auto __first = std::ranges::begin (*_M_uptr);
+		std::rotate (__first, __first + _M_head, std::ranges::end (*_M_uptr));
+		_M_head = 0;
+		__detail::__resize_for_overwrite (*_M_uptr, std::bit_ceil (__n));
+	}
+
+	_Tp* _M_uptr;
+	std::size_t _M_head;
+	std::size_t _M_size;
+	std::size_t _M_prepared;
+};
+
+// _Adaptor is the storage policy: basic_buffer_adaptor keeps the bytes
+// contiguous at the front of the container, basic_ring_buffer_adaptor uses
+// it as a ring.
+template <basic_buffer_underlying _Tp,
+	template <typename> class _Adaptor = basic_buffer_adaptor>
 class basic_buffer
 {
-	using _Adaptor_type = basic_buffer_adaptor<_Tp>;
+	using _Adaptor_type = _Adaptor<_Tp>;
 public:
-  	using value_type = range_iter_value_type<_Adaptor_type>;
+  	using value_type = range_iter_value_type<_Tp>;
 	using size_type = std::size_t;
 	using difference_type = std::ptrdiff_t;
 	using pointer = value_type *;
@@ -132,12 +285,12 @@ public:
 	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
 public:
-  template<typename _Tp>
-  requires (basic_buffer_underlying<std::remove_cvref_t<_Tp>> 
-    && !std::same_as<basic_buffer, std::remove_cvref_t<_Tp>>)
-  basic_buffer(_Tp&& __t) 
-  noexcept(std::is_nothrow_constructible_v<_Adaptor, _Tp>)
-  	: _M_adaptor(std::forward<_Tp>(__t))
+  template<typename _Up>
+  requires (basic_buffer_underlying<std::remove_cvref_t<_Up>> 
+    && !std::same_as<basic_buffer, std::remove_cvref_t<_Up>>)
+  basic_buffer(_Up&& __t) 
+  noexcept(std::is_nothrow_constructible_v<_Adaptor_type, _Up>)
+  	: _M_adaptor(std::forward<_Up>(__t))
   { }
 
   constexpr decltype (auto)
@@ -146,19 +299,19 @@ public:
 
   constexpr auto
   size () const noexcept
-  { return std::ranges::size (_M_adaptor); }
+  { return _M_adaptor.size (); }
 
   constexpr auto
   data () noexcept
-  { return std::ranges::data (_M_adaptor); }
+  { return _M_adaptor.data (); }
 
   constexpr auto
   data () const noexcept
-  { return std::ranges::data (_M_adaptor); }
+  { return _M_adaptor.data (); }
 
   constexpr auto
   empty () const
-  { return std::ranges::empty (_M_adaptor); }
+  { return _M_adaptor.empty (); }
 
   constexpr auto
   begin () noexcept
@@ -235,6 +388,9 @@ private:
 template<typename _Tp>
 basic_buffer(_Tp&&) -> basic_buffer<std::remove_reference_t<_Tp>>;
 
+template <basic_buffer_underlying _Tp>
+using ring_buffer = basic_buffer<_Tp, basic_ring_buffer_adaptor>;
+
 } // namespace basic
 
 #endif // __LIBBASIC_BUFFER_H__
\ No newline at end of file
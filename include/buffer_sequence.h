@@ -0,0 +1,252 @@
+#ifndef __LIBBASIC_BUFFER_SEQUENCE_H__
+#define __LIBBASIC_BUFFER_SEQUENCE_H__
+
+#include "byte_view.h"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <deque>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#if __has_include(<sys/uio.h>)
+#include <sys/uio.h>
+#define __LIBBASIC_HAS_IOVEC 1
+#endif
+
+namespace basic
+{
+
+// A buffer sequence is a forward range of byte views, read or written as
+// one logical run of bytes, e.g. by a single writev or readv call.
+template <typename _Tp>
+concept const_buffer_sequence
+    = std::ranges::forward_range<const _Tp>
+      && std::convertible_to<std::ranges::range_reference_t<const _Tp>,
+                             byte_view>;
+
+template <typename _Tp>
+concept mutable_buffer_sequence
+    = std::ranges::forward_range<const _Tp>
+      && std::convertible_to<std::ranges::range_reference_t<const _Tp>,
+                             mutable_byte_view>;
+
+// Total number of bytes in __seq.
+template <const_buffer_sequence _Seq>
+constexpr std::size_t
+buffer_size (const _Seq &__seq)
+{
+  std::size_t __n = 0;
+  for (byte_view __v : __seq)
+    __n += __v.size ();
+  return __n;
+}
+
+// Up to _Nm views kept inline, the usual shape of a gather list: a frame
+// header, its payload and a few neighbours.
+template <typename _View, std::size_t _Nm> class basic_byte_view_array
+{
+public:
+  typedef _View value_type;
+  typedef std::size_t size_type;
+  typedef const _View *const_iterator;
+  typedef const _View *iterator;
+
+  constexpr basic_byte_view_array () noexcept = default;
+
+  // Empty views are dropped; returns false when the array is full.
+  constexpr bool
+  push_back (_View __v) noexcept
+  {
+    if (__v.empty ())
+      return true;
+    if (_M_count == _Nm)
+      return false;
+    _M_views[_M_count++] = __v;
+    return true;
+  }
+
+  constexpr size_type
+  size () const noexcept
+  {
+    return _M_count;
+  }
+
+  static constexpr size_type
+  max_size () noexcept
+  {
+    return _Nm;
+  }
+
+  constexpr bool
+  empty () const noexcept
+  {
+    return _M_count == 0;
+  }
+
+  constexpr const _View &
+  operator[] (size_type __i) const noexcept
+  {
+    return _M_views[__i];
+  }
+
+  constexpr const_iterator
+  begin () const noexcept
+  {
+    return _M_views.data ();
+  }
+
+  constexpr const_iterator
+  end () const noexcept
+  {
+    return _M_views.data () + _M_count;
+  }
+
+  // Drops the first __n bytes, e.g. after a short writev.
+  constexpr void
+  consume (std::size_t __n) noexcept
+  {
+    size_type __i = 0;
+    while (__i != _M_count && __n >= _M_views[__i].size ())
+      __n -= _M_views[__i++].size ();
+    if (__i != _M_count)
+      _M_views[__i] = _M_views[__i].subview (__n, _M_views[__i].size () - __n);
+    std::move (_M_views.begin () + __i, _M_views.begin () + _M_count,
+               _M_views.begin ());
+    _M_count -= __i;
+  }
+
+  constexpr void
+  clear () noexcept
+  {
+    _M_count = 0;
+  }
+
+private:
+  std::array<_View, _Nm> _M_views{};
+  size_type _M_count = 0;
+};
+
+template <std::size_t _Nm>
+using byte_view_array = basic_byte_view_array<byte_view, _Nm>;
+
+template <std::size_t _Nm>
+using mutable_byte_view_array = basic_byte_view_array<mutable_byte_view, _Nm>;
+
+// Owns a queue of separately allocated chunks and exposes them as a buffer
+// sequence, so encoded frames are queued by moving their storage in rather
+// than by copying them onto the end of one vector.
+template <typename _Byte = byte, typename _Alloc = std::allocator<_Byte> >
+class chunked_buffer
+{
+public:
+  typedef std::vector<_Byte, _Alloc> chunk_type;
+  typedef std::size_t size_type;
+
+  chunked_buffer () = default;
+
+  void
+  append (chunk_type &&__chunk)
+  {
+    if (__chunk.empty ())
+      return;
+    _M_size += __chunk.size ();
+    _M_chunks.push_back (_Chunk{ std::move (__chunk), 0 });
+  }
+
+  void
+  append (byte_view __bytes)
+  {
+    const _Byte *__p = reinterpret_cast<const _Byte *> (__bytes.data ());
+    append (chunk_type (__p, __p + __bytes.size ()));
+  }
+
+  size_type
+  size () const noexcept
+  {
+    return _M_size;
+  }
+
+  bool
+  empty () const noexcept
+  {
+    return _M_size == 0;
+  }
+
+  // The unconsumed bytes, one view per chunk.
+  auto
+  data () const
+  {
+    return _M_chunks | std::views::transform ([] (const _Chunk &__c) {
+             return byte_view (__c._M_bytes).subview (
+                 __c._M_offset, __c._M_bytes.size () - __c._M_offset);
+           });
+  }
+
+  // Releases fully consumed chunks; a partially consumed one only moves
+  // its offset.
+  void
+  consume (size_type __n)
+  {
+    __n = std::min (__n, _M_size);
+    _M_size -= __n;
+    while (__n != 0)
+      {
+        _Chunk &__front = _M_chunks.front ();
+        size_type __left = __front._M_bytes.size () - __front._M_offset;
+        if (__n < __left)
+          {
+            __front._M_offset += __n;
+            return;
+          }
+        __n -= __left;
+        _M_chunks.pop_front ();
+      }
+  }
+
+  void
+  clear () noexcept
+  {
+    _M_chunks.clear ();
+    _M_size = 0;
+  }
+
+private:
+  struct _Chunk
+  {
+    chunk_type _M_bytes;
+    size_type _M_offset;
+  };
+
+  std::deque<_Chunk> _M_chunks;
+  size_type _M_size = 0;
+};
+
+#ifdef __LIBBASIC_HAS_IOVEC
+// Fills __out with the non-empty views of __seq, as many as fit, and
+// returns the number of entries used, ready for writev or readv.
+template <const_buffer_sequence _Seq>
+std::size_t
+to_iovec (const _Seq &__seq, std::span<iovec> __out) noexcept
+{
+  std::size_t __i = 0;
+  for (byte_view __v : __seq)
+    {
+      if (__i == __out.size ())
+        break;
+      if (__v.empty ())
+        continue;
+      __out[__i].iov_base
+          = const_cast<void *> (static_cast<const void *> (__v.data ()));
+      __out[__i].iov_len = __v.size ();
+      ++__i;
+    }
+  return __i;
+}
+#endif
+
+} // namespace basic
+
+#endif //__LIBBASIC_BUFFER_SEQUENCE_H__
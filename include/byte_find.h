@@ -0,0 +1,89 @@
+#ifndef __LIBBASIC_BYTE_FIND_H__
+#define __LIBBASIC_BYTE_FIND_H__
+
+#include "byte_view.h"
+#include "cpu.h"
+#include <bit>
+#include <cstddef>
+#include <cstring>
+
+namespace basic
+{
+
+namespace __detail
+{
+
+#ifdef __LIBBASIC_X86
+// Uses the first and last needle bytes as a filter: a vector compare
+// against each marks the offsets where both match, and only those are
+// checked with memcmp.
+__attribute__ ((target ("avx2"))) inline std::size_t
+__byte_find_avx2 (const unsigned char *__h, std::size_t __n,
+                  const unsigned char *__s, std::size_t __m) noexcept
+{
+  const __m256i __first = _mm256_set1_epi8 (char (__s[0]));
+  const __m256i __final = _mm256_set1_epi8 (char (__s[__m - 1]));
+  std::size_t __i = 0;
+  for (; __i + __m - 1 + 32 <= __n; __i += 32)
+    {
+      __m256i __a = _mm256_loadu_si256 (
+          reinterpret_cast<const __m256i *> (__h + __i));
+      __m256i __b = _mm256_loadu_si256 (
+          reinterpret_cast<const __m256i *> (__h + __i + __m - 1));
+      unsigned __mask = static_cast<unsigned> (_mm256_movemask_epi8 (
+          _mm256_and_si256 (_mm256_cmpeq_epi8 (__a, __first),
+                            _mm256_cmpeq_epi8 (__b, __final))));
+      while (__mask != 0)
+        {
+          std::size_t __k = __i + std::countr_zero (__mask);
+          if (std::memcmp (__h + __k + 1, __s + 1, __m - 2) == 0)
+            return __k;
+          __mask &= __mask - 1;
+        }
+    }
+  std::size_t __r = __byte_find_scalar (__h + __i, __n - __i, __s, __m);
+  return __r == __n - __i ? __n : __i + __r;
+}
+#endif
+
+typedef std::size_t (*_Byte_find_fn) (const unsigned char *, std::size_t,
+                                      const unsigned char *, std::size_t);
+
+inline std::size_t
+__byte_find_dispatch (const unsigned char *__h, std::size_t __n,
+                      const unsigned char *__s, std::size_t __m) noexcept
+{
+  static const _Byte_find_fn __fn = cpu_select<_Byte_find_fn> ({
+#ifdef __LIBBASIC_X86
+      { cpu_level::avx2, __byte_find_avx2 },
+#endif
+      { cpu_level::scalar, __byte_find_scalar },
+  });
+  return __fn (__h, __n, __s, __m);
+}
+
+}
+
+// byte_view::find with the multi-byte search dispatched to the widest
+// kernel the processor supports.  Kept out of byte_view.h so that only
+// callers searching long inputs pull in cpu.h and the intrinsics headers.
+inline std::size_t
+byte_find (byte_view __haystack, byte_view __needle,
+           std::size_t __pos = 0) noexcept
+{
+  if (__pos > __haystack.size ())
+    return byte_view::npos;
+  std::size_t __n = __haystack.size () - __pos;
+  std::size_t __m = __needle.size ();
+  if (__m < 2 || __m > __n)
+    return __haystack.find (__needle, __pos);
+  auto __h = reinterpret_cast<const unsigned char *> (__haystack.data ())
+             + __pos;
+  auto __s = reinterpret_cast<const unsigned char *> (__needle.data ());
+  std::size_t __r = __detail::__byte_find_dispatch (__h, __n, __s, __m);
+  return __r == __n ? byte_view::npos : __pos + __r;
+}
+
+} // namespace basic
+
+#endif //__LIBBASIC_BYTE_FIND_H__
@@ -3,7 +3,11 @@
 
 #include "byte.h"
 #include "type_traits.h"
+#include <compare>
 #include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 
 // clang-format off
 
@@ -49,6 +53,71 @@ namespace __detail {
 		{ __decay_copy (as_byte_view (__t)) } -> __byte_view_like;
 	};
 
+	// Candidates are found with memchr on the first needle byte, which
+	// libc vectorizes already, and checked with memcmp.  byte_find.h has
+	// an AVX2 version for long searches.
+	inline std::size_t
+	__byte_find_scalar (const unsigned char *__h, std::size_t __n,
+		const unsigned char *__s, std::size_t __m) noexcept
+	{
+		const unsigned char *__p = __h;
+		const unsigned char *__last = __h + (__n - __m) + 1;
+		while (__p != __last)
+		{
+			__p = static_cast<const unsigned char *> (
+				std::memchr (__p, __s[0], __last - __p));
+			if (__p == nullptr)
+				break;
+			if (std::memcmp (__p + 1, __s + 1, __m - 1) == 0)
+				return __p - __h;
+			++__p;
+		}
+		return __n;
+	}
+
+	// Offset of the first occurrence of [__s, __s + __m) in
+	// [__h, __h + __n), or __n if there is none.
+	inline std::size_t
+	__byte_find (const void *__hp, std::size_t __n,
+		const void *__sp, std::size_t __m) noexcept
+	{
+		auto __h = static_cast<const unsigned char *> (__hp);
+		auto __s = static_cast<const unsigned char *> (__sp);
+		if (__m == 0)
+			return 0;
+		if (__m > __n)
+			return __n;
+		if (__m == 1)
+		{
+			const void *__p = std::memchr (__h, __s[0], __n);
+			return __p ? static_cast<const unsigned char *> (__p) - __h : __n;
+		}
+		return __byte_find_scalar (__h, __n, __s, __m);
+	}
+
+	// Word-at-a-time hash of a byte string; the length is mixed in so
+	// that strings differing only by trailing zeros hash apart.
+	inline std::size_t
+	__byte_hash (const void *__p, std::size_t __n) noexcept
+	{
+		auto __b = static_cast<const unsigned char *> (__p);
+		std::uint64_t __h = 0x9e3779b97f4a7c15ull ^ __n;
+		std::size_t __i = 0;
+		for (; __i + 8 <= __n; __i += 8)
+		{
+			std::uint64_t __w;
+			std::memcpy (&__w, __b + __i, 8);
+			__h = (__h ^ __w) * 0xff51afd7ed558ccdull;
+		}
+		if (__i != __n)
+		{
+			std::uint64_t __w = 0;
+			std::memcpy (&__w, __b + __i, __n - __i);
+			__h = (__h ^ __w) * 0xff51afd7ed558ccdull;
+		}
+		return static_cast<std::size_t> (__h ^ (__h >> 32));
+	}
+
 }
 
 template <typename _Tp>
@@ -146,11 +215,13 @@ public:
   	constexpr 
   	basic_byte_view (const basic_byte_view &) noexcept = default;
 
+  	// Adding const is implicit, as for std::span; reinterpreting the byte
+  	// type must be spelled out.
   	template <typename _Up>
 	requires (!std::is_same_v<_Up, _Tp> && __is_byte_compatible_v<_Up>)
-    constexpr explicit
+    constexpr explicit (!std::is_same_v<std::remove_cv_t<_Up>, std::remove_cv_t<_Tp>>)
 	basic_byte_view (const basic_byte_view<_Up> &__x) noexcept 
-	: _M_ptr (__x._M_ptr), _M_size (__x._M_size)
+	: _M_ptr (__byte_cast (__x.data ())), _M_size (__x.size ())
   	{ }
 
   	~basic_byte_view () noexcept = default;
@@ -232,7 +303,80 @@ public:
 		return { this->_M_ptr + __offset, __size };
 	}
 
+	static constexpr size_type npos = size_type (-1);
+
+	// Content comparisons, as for std::string_view: bytes compare as
+	// unsigned char and a prefix orders before the longer view.  At run
+	// time they go to memcmp, which libc vectorizes.
+	constexpr int
+	compare (basic_byte_view __x) const noexcept
+	{
+		size_type __n = std::min (_M_size, __x._M_size);
+		int __r = 0;
+		if (std::is_constant_evaluated ())
+		{
+			for (size_type __i = 0; __i != __n && __r == 0; ++__i)
+				__r = int (_S_value (_M_ptr[__i]))
+					- int (_S_value (__x._M_ptr[__i]));
+		}
+		else if (__n != 0)
+			__r = std::memcmp (_M_ptr, __x._M_ptr, __n);
+		if (__r != 0)
+			return __r;
+		return _M_size < __x._M_size ? -1 : _M_size > __x._M_size ? 1 : 0;
+	}
+
+	constexpr bool
+	starts_with (basic_byte_view __x) const noexcept
+	{
+		return _M_size >= __x._M_size
+			&& basic_byte_view (*this, __x._M_size) == __x;
+	}
+
+	constexpr bool
+	ends_with (basic_byte_view __x) const noexcept
+	{
+		return _M_size >= __x._M_size
+			&& subview (_M_size - __x._M_size, __x._M_size) == __x;
+	}
+
+	size_type
+	find (basic_byte_view __x, size_type __pos = 0) const noexcept
+	{
+		if (__pos > _M_size)
+			return npos;
+		size_type __r = __detail::__byte_find (_M_ptr + __pos, _M_size - __pos,
+			__x._M_ptr, __x._M_size);
+		return __r == _M_size - __pos && __x._M_size != 0 ? npos : __pos + __r;
+	}
+
+	size_type
+	find (std::remove_cv_t<_Tp> __b, size_type __pos = 0) const noexcept
+	{
+		if (__pos >= _M_size)
+			return npos;
+		const void *__p = std::memchr (_M_ptr + __pos, _S_value (__b),
+			_M_size - __pos);
+		return __p ? static_cast<const _Tp *> (__p) - _M_ptr : npos;
+	}
+
+	bool
+	contains (basic_byte_view __x) const noexcept
+	{ return find (__x) != npos; }
+
+	friend constexpr bool
+	operator== (basic_byte_view __x, basic_byte_view __y) noexcept
+	{ return __x._M_size == __y._M_size && __x.compare (__y) == 0; }
+
+	friend constexpr std::strong_ordering
+	operator<=> (basic_byte_view __x, basic_byte_view __y) noexcept
+	{ return __x.compare (__y) <=> 0; }
+
 private:
+	static constexpr unsigned char
+	_S_value (std::remove_cv_t<_Tp> __b) noexcept
+	{ return static_cast<unsigned char> (__b); }
+
 	pointer _M_ptr;
 	size_type _M_size;
 };
@@ -317,4 +461,13 @@ concept as_byte_view_from = requires(_Tp&& __t) {
 
 
 }
+
+template <typename _Tp>
+struct std::hash<basic::basic_byte_view<_Tp>>
+{
+	std::size_t
+	operator() (basic::basic_byte_view<_Tp> __x) const noexcept
+	{ return basic::__detail::__byte_hash (__x.data (), __x.size ()); }
+};
+
 #endif //__LIBBASIC_BYTE_VIEW_H__
\ No newline at end of file
@@ -2,10 +2,16 @@
 #define __LIBBASIC_BYTES_H__
 
 #include "byte.h"
+#include <memory_resource>
 #include <vector>
 
 namespace basic
 {
     using bytes = std::vector<byte>;
+
+    namespace pmr
+    {
+        using bytes = std::vector<byte, std::pmr::polymorphic_allocator<byte>>;
+    } // namespace pmr
 } // namespace basic
 #endif //__LIBBASIC_BYTES_H__
\ No newline at end of file
@@ -0,0 +1,114 @@
+#ifndef __LIBBASIC_CPU_H__
+#define __LIBBASIC_CPU_H__
+
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define __LIBBASIC_X86 1
+#endif
+
+namespace basic
+{
+
+// Instruction set levels the byte kernels are written for, each implying
+// the ones before it.
+enum class cpu_level
+{
+  scalar,
+  sse2,
+  ssse3,
+  avx2,
+  avx512bw,
+};
+
+namespace __detail
+{
+
+inline cpu_level
+__cpu_probe () noexcept
+{
+#ifdef __LIBBASIC_X86
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx512bw"))
+    return cpu_level::avx512bw;
+  if (__builtin_cpu_supports ("avx2"))
+    return cpu_level::avx2;
+  if (__builtin_cpu_supports ("ssse3"))
+    return cpu_level::ssse3;
+  if (__builtin_cpu_supports ("sse2"))
+    return cpu_level::sse2;
+#endif
+  return cpu_level::scalar;
+}
+
+// LIBBASIC_CPU caps the level, e.g. LIBBASIC_CPU=scalar to debug without
+// any vector kernel.  It can only lower what the processor supports.
+inline cpu_level
+__cpu_select_level () noexcept
+{
+  cpu_level __level = __cpu_probe ();
+  const char *__env = std::getenv ("LIBBASIC_CPU");
+  if (__env == nullptr)
+    return __level;
+  static constexpr std::pair<const char *, cpu_level> __names[] = {
+    { "scalar", cpu_level::scalar }, { "sse2", cpu_level::sse2 },
+    { "ssse3", cpu_level::ssse3 },   { "avx2", cpu_level::avx2 },
+    { "avx512bw", cpu_level::avx512bw },
+  };
+  for (const auto &__n : __names)
+    if (std::strcmp (__env, __n.first) == 0)
+      return __n.second < __level ? __n.second : __level;
+  return __level;
+}
+
+}
+
+// The level kernels are dispatched on, probed once.
+inline cpu_level
+cpu_dispatch_level () noexcept
+{
+  static const cpu_level __level = __detail::__cpu_select_level ();
+  return __level;
+}
+
+namespace __detail
+{
+
+template <typename _Impl>
+_Impl
+__cpu_select_for (
+    cpu_level __level,
+    std::initializer_list<std::pair<cpu_level, _Impl> > __impls) noexcept
+{
+  const std::pair<cpu_level, _Impl> *__best = nullptr;
+  for (const auto &__impl : __impls)
+    if (__impl.first <= __level
+        && (__best == nullptr || __impl.first > __best->first))
+      __best = &__impl;
+  return __best != nullptr ? __best->second : _Impl ();
+}
+
+}
+
+// Returns the implementation, a function pointer or a table of them, for
+// the highest level in __impls that the dispatch level allows; list a
+// scalar entry to always find one.  Callers keep the result in a
+// function-local static so the choice is made once:
+//
+//   static const _Fn __fn = cpu_select<_Fn> ({
+//       { cpu_level::avx2, __f_avx2 }, { cpu_level::scalar, __f_scalar } });
+template <typename _Impl>
+_Impl
+cpu_select (
+    std::initializer_list<std::pair<cpu_level, _Impl> > __impls) noexcept
+{
+  return __detail::__cpu_select_for (cpu_dispatch_level (), __impls);
+}
+
+} // namespace basic
+
+#endif //__LIBBASIC_CPU_H__
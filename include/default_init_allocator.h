@@ -0,0 +1,65 @@
+#ifndef __LIBBASIC_DEFAULT_INIT_ALLOCATOR_H__
+#define __LIBBASIC_DEFAULT_INIT_ALLOCATOR_H__
+
+#include "byte.h"
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace basic
+{
+
+// Wraps _Alloc so that containers default-initialize instead of
+// value-initializing: vector::resize then leaves new bytes indeterminate
+// rather than zeroing memory the caller is about to overwrite.  Every other
+// construction is passed on to _Alloc.
+template <typename _Tp, typename _Alloc = std::allocator<_Tp> >
+class default_init_allocator : public _Alloc
+{
+  typedef std::allocator_traits<_Alloc> _Traits;
+
+public:
+  template <typename _Up> struct rebind
+  {
+    typedef default_init_allocator<
+        _Up, typename _Traits::template rebind_alloc<_Up> >
+        other;
+  };
+
+  using _Alloc::_Alloc;
+
+  constexpr default_init_allocator () = default;
+
+  template <typename _Up, typename _Other>
+  constexpr default_init_allocator (
+      const default_init_allocator<_Up, _Other> &__x) noexcept
+      : _Alloc (static_cast<const _Other &> (__x))
+  {
+  }
+
+  template <typename _Up>
+  void
+  construct (_Up *__p) noexcept (std::is_nothrow_default_constructible_v<_Up>)
+  {
+    ::new (static_cast<void *> (__p)) _Up;
+  }
+
+  template <typename _Up, typename... _Args>
+  void
+  construct (_Up *__p, _Args &&...__args)
+  {
+    _Traits::construct (static_cast<_Alloc &> (*this), __p,
+                        std::forward<_Args> (__args)...);
+  }
+};
+
+namespace uninit
+{
+using bytes = std::vector<byte, default_init_allocator<byte> >;
+}
+
+} // namespace basic
+
+#endif //__LIBBASIC_DEFAULT_INIT_ALLOCATOR_H__
@@ -0,0 +1,181 @@
+#ifndef __LIBBASIC_FIXED_BYTES_H__
+#define __LIBBASIC_FIXED_BYTES_H__
+
+#include "byte.h"
+#include "byte_view.h"
+#include "hex.h"
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace basic
+{
+
+namespace __detail
+{
+
+// The widest power of two up to 32 dividing _Nm, so that aligning never
+// adds padding: h256 gets 32, h160 gets 4.
+constexpr std::size_t
+__fixed_bytes_align (std::size_t __n) noexcept
+{
+  std::size_t __a = 32;
+  while (__n % __a != 0)
+    __a /= 2;
+  return __a;
+}
+
+}
+
+// A fixed-width byte string such as a hash or an address.  Trivially
+// copyable and stored inline, it compares and hashes whole words at a time.
+template <std::size_t _Nm>
+struct alignas (__detail::__fixed_bytes_align (_Nm)) fixed_bytes
+{
+  typedef byte value_type;
+  typedef std::size_t size_type;
+  typedef byte *pointer;
+  typedef const byte *const_pointer;
+  typedef byte *iterator;
+  typedef const byte *const_iterator;
+
+  static constexpr size_type extent = _Nm;
+
+  std::array<byte, _Nm> _M_bytes;
+
+  // Parses exactly 2 * _Nm hex digits, optionally prefixed by "0x".  Usable
+  // in constant expressions, where malformed input fails to compile.
+  static constexpr fixed_bytes
+  from_hex (std::string_view __hex)
+  {
+    if (__hex.size () >= 2 && __hex[0] == '0'
+        && (__hex[1] == 'x' || __hex[1] == 'X'))
+      __hex.remove_prefix (2);
+    if (__hex.size () != 2 * _Nm)
+      throw std::invalid_argument ("fixed_bytes::from_hex: bad length");
+    fixed_bytes __r{};
+    for (size_type __i = 0; __i != _Nm; ++__i)
+      {
+        std::uint8_t __hi
+            = __detail::__hex_values[std::uint8_t (__hex[2 * __i])];
+        std::uint8_t __lo
+            = __detail::__hex_values[std::uint8_t (__hex[2 * __i + 1])];
+        if ((__hi | __lo) == 0xff)
+          throw std::invalid_argument ("fixed_bytes::from_hex: bad digit");
+        __r._M_bytes[__i] = static_cast<byte> (__hi << 4 | __lo);
+      }
+    return __r;
+  }
+
+  // Copies __bytes, which must hold exactly _Nm bytes.
+  static fixed_bytes
+  from_view (byte_view __bytes)
+  {
+    if (__bytes.size () != _Nm)
+      throw std::invalid_argument ("fixed_bytes::from_view: bad length");
+    fixed_bytes __r;
+    std::memcpy (__r._M_bytes.data (), __bytes.data (), _Nm);
+    return __r;
+  }
+
+  static constexpr size_type
+  size () noexcept
+  {
+    return _Nm;
+  }
+
+  constexpr pointer
+  data () noexcept
+  {
+    return _M_bytes.data ();
+  }
+
+  constexpr const_pointer
+  data () const noexcept
+  {
+    return _M_bytes.data ();
+  }
+
+  constexpr iterator
+  begin () noexcept
+  {
+    return data ();
+  }
+
+  constexpr const_iterator
+  begin () const noexcept
+  {
+    return data ();
+  }
+
+  constexpr iterator
+  end () noexcept
+  {
+    return data () + _Nm;
+  }
+
+  constexpr const_iterator
+  end () const noexcept
+  {
+    return data () + _Nm;
+  }
+
+  constexpr byte &
+  operator[] (size_type __i) noexcept
+  {
+    return _M_bytes[__i];
+  }
+
+  constexpr const byte &
+  operator[] (size_type __i) const noexcept
+  {
+    return _M_bytes[__i];
+  }
+
+  constexpr bool
+  is_zero () const noexcept
+  {
+    return *this == fixed_bytes{};
+  }
+
+  // memcmp of a constant size is expanded by the compiler into a few wide
+  // loads, so these stay branch-light vector compares.
+  friend constexpr bool
+  operator== (const fixed_bytes &__x, const fixed_bytes &__y) noexcept
+  {
+    if (std::is_constant_evaluated ())
+      return __x._M_bytes == __y._M_bytes;
+    return std::memcmp (__x.data (), __y.data (), _Nm) == 0;
+  }
+
+  friend constexpr std::strong_ordering
+  operator<=> (const fixed_bytes &__x, const fixed_bytes &__y) noexcept
+  {
+    if (std::is_constant_evaluated ())
+      return __x._M_bytes <=> __y._M_bytes;
+    return std::memcmp (__x.data (), __y.data (), _Nm) <=> 0;
+  }
+};
+
+typedef fixed_bytes<32> h256;
+typedef fixed_bytes<20> h160;
+typedef fixed_bytes<64> h512;
+
+} // namespace basic
+
+// Hashes as the byte_view of the same bytes does.
+template <std::size_t _Nm> struct std::hash<basic::fixed_bytes<_Nm> >
+{
+  std::size_t
+  operator() (const basic::fixed_bytes<_Nm> &__x) const noexcept
+  {
+    return basic::__detail::__byte_hash (__x.data (), _Nm);
+  }
+};
+
+#endif //__LIBBASIC_FIXED_BYTES_H__
@@ -0,0 +1,304 @@
+#ifndef __LIBBASIC_HEX_H__
+#define __LIBBASIC_HEX_H__
+
+#include "byte_view.h"
+#include "cpu.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace basic
+{
+
+// As std::from_chars_result: ptr is one past the last digit decoded, or
+// the offending character.
+struct hex_decode_result
+{
+  const char *ptr;
+  std::errc ec;
+
+  explicit
+  operator bool () const noexcept
+  {
+    return ec == std::errc ();
+  }
+};
+
+namespace __detail
+{
+
+inline constexpr char __hex_digits[] = "0123456789abcdef";
+
+// Nibble value of each character, or 0xff.
+inline constexpr auto __hex_values = [] {
+  std::array<std::uint8_t, 256> __t{};
+  for (std::size_t __i = 0; __i != 256; ++__i)
+    __t[__i] = 0xff;
+  for (std::uint8_t __i = 0; __i != 10; ++__i)
+    __t['0' + __i] = __i;
+  for (std::uint8_t __i = 0; __i != 6; ++__i)
+    __t['a' + __i] = __t['A' + __i] = 10 + __i;
+  return __t;
+}();
+
+inline void
+__hex_encode_scalar (const std::uint8_t *__in, std::size_t __n,
+                     char *__out) noexcept
+{
+  for (std::size_t __i = 0; __i != __n; ++__i)
+    {
+      *__out++ = __hex_digits[__in[__i] >> 4];
+      *__out++ = __hex_digits[__in[__i] & 0xf];
+    }
+}
+
+// Decodes __n bytes from 2 * __n digits and returns the index of the first
+// bad pair, or __n.
+inline std::size_t
+__hex_decode_scalar (const char *__in, std::size_t __n,
+                     std::uint8_t *__out) noexcept
+{
+  for (std::size_t __i = 0; __i != __n; ++__i)
+    {
+      std::uint8_t __hi = __hex_values[std::uint8_t (__in[2 * __i])];
+      std::uint8_t __lo = __hex_values[std::uint8_t (__in[2 * __i + 1])];
+      if ((__hi | __lo) == 0xff)
+        return __i;
+      __out[__i] = std::uint8_t (__hi << 4 | __lo);
+    }
+  return __n;
+}
+
+#ifdef __LIBBASIC_X86
+// Both directions work on nibbles: encoding looks each one up with pshufb,
+// decoding validates digits with range compares and merges nibble pairs
+// with one pmaddubsw.
+
+__attribute__ ((target ("ssse3"))) inline __m128i
+__hex_nibbles_ssse3 (__m128i __c, int &__bad) noexcept
+{
+  __m128i __lower = _mm_or_si128 (__c, _mm_set1_epi8 (0x20));
+  __m128i __digit
+      = _mm_and_si128 (_mm_cmpgt_epi8 (__c, _mm_set1_epi8 ('0' - 1)),
+                       _mm_cmplt_epi8 (__c, _mm_set1_epi8 ('9' + 1)));
+  __m128i __alpha
+      = _mm_and_si128 (_mm_cmpgt_epi8 (__lower, _mm_set1_epi8 ('a' - 1)),
+                       _mm_cmplt_epi8 (__lower, _mm_set1_epi8 ('f' + 1)));
+  __bad |= _mm_movemask_epi8 (_mm_or_si128 (__digit, __alpha)) ^ 0xffff;
+  __m128i __dv = _mm_sub_epi8 (__c, _mm_set1_epi8 ('0'));
+  __m128i __av = _mm_sub_epi8 (__lower, _mm_set1_epi8 ('a' - 10));
+  return _mm_or_si128 (_mm_and_si128 (__digit, __dv),
+                       _mm_andnot_si128 (__digit, __av));
+}
+
+__attribute__ ((target ("ssse3"))) inline void
+__hex_encode_ssse3 (const std::uint8_t *__in, std::size_t __n,
+                    char *__out) noexcept
+{
+  const __m128i __lut = _mm_loadu_si128 (
+      reinterpret_cast<const __m128i *> (__hex_digits));
+  const __m128i __mask = _mm_set1_epi8 (0x0f);
+  std::size_t __i = 0;
+  for (; __i + 16 <= __n; __i += 16, __out += 32)
+    {
+      __m128i __v = _mm_loadu_si128 (
+          reinterpret_cast<const __m128i *> (__in + __i));
+      __m128i __hi = _mm_shuffle_epi8 (
+          __lut, _mm_and_si128 (_mm_srli_epi16 (__v, 4), __mask));
+      __m128i __lo = _mm_shuffle_epi8 (__lut, _mm_and_si128 (__v, __mask));
+      _mm_storeu_si128 (reinterpret_cast<__m128i *> (__out),
+                        _mm_unpacklo_epi8 (__hi, __lo));
+      _mm_storeu_si128 (reinterpret_cast<__m128i *> (__out + 16),
+                        _mm_unpackhi_epi8 (__hi, __lo));
+    }
+  __hex_encode_scalar (__in + __i, __n - __i, __out);
+}
+
+__attribute__ ((target ("ssse3"))) inline std::size_t
+__hex_decode_ssse3 (const char *__in, std::size_t __n,
+                    std::uint8_t *__out) noexcept
+{
+  const __m128i __weights = _mm_set1_epi16 (0x0110);
+  std::size_t __i = 0;
+  for (; __i + 16 <= __n; __i += 16)
+    {
+      int __bad = 0;
+      __m128i __a = __hex_nibbles_ssse3 (
+          _mm_loadu_si128 (
+              reinterpret_cast<const __m128i *> (__in + 2 * __i)),
+          __bad);
+      __m128i __b = __hex_nibbles_ssse3 (
+          _mm_loadu_si128 (
+              reinterpret_cast<const __m128i *> (__in + 2 * __i + 16)),
+          __bad);
+      if (__bad != 0)
+        break;
+      __m128i __bytes = _mm_packus_epi16 (_mm_maddubs_epi16 (__a, __weights),
+                                          _mm_maddubs_epi16 (__b, __weights));
+      _mm_storeu_si128 (reinterpret_cast<__m128i *> (__out + __i), __bytes);
+    }
+  return __i + __hex_decode_scalar (__in + 2 * __i, __n - __i, __out + __i);
+}
+
+__attribute__ ((target ("avx2"))) inline void
+__hex_encode_avx2 (const std::uint8_t *__in, std::size_t __n,
+                   char *__out) noexcept
+{
+  const __m256i __lut = _mm256_broadcastsi128_si256 (_mm_loadu_si128 (
+      reinterpret_cast<const __m128i *> (__hex_digits)));
+  const __m256i __mask = _mm256_set1_epi8 (0x0f);
+  std::size_t __i = 0;
+  for (; __i + 32 <= __n; __i += 32, __out += 64)
+    {
+      __m256i __v = _mm256_loadu_si256 (
+          reinterpret_cast<const __m256i *> (__in + __i));
+      __m256i __hi = _mm256_shuffle_epi8 (
+          __lut, _mm256_and_si256 (_mm256_srli_epi16 (__v, 4), __mask));
+      __m256i __lo
+          = _mm256_shuffle_epi8 (__lut, _mm256_and_si256 (__v, __mask));
+      // Unpacking works within 128-bit lanes; put the halves back in order.
+      __m256i __x = _mm256_unpacklo_epi8 (__hi, __lo);
+      __m256i __y = _mm256_unpackhi_epi8 (__hi, __lo);
+      _mm256_storeu_si256 (reinterpret_cast<__m256i *> (__out),
+                           _mm256_permute2x128_si256 (__x, __y, 0x20));
+      _mm256_storeu_si256 (reinterpret_cast<__m256i *> (__out + 32),
+                           _mm256_permute2x128_si256 (__x, __y, 0x31));
+    }
+  __hex_encode_ssse3 (__in + __i, __n - __i, __out);
+}
+
+__attribute__ ((target ("avx2"))) inline __m256i
+__hex_nibbles_avx2 (__m256i __c, unsigned &__bad) noexcept
+{
+  __m256i __lower = _mm256_or_si256 (__c, _mm256_set1_epi8 (0x20));
+  __m256i __digit = _mm256_and_si256 (
+      _mm256_cmpgt_epi8 (__c, _mm256_set1_epi8 ('0' - 1)),
+      _mm256_cmpgt_epi8 (_mm256_set1_epi8 ('9' + 1), __c));
+  __m256i __alpha = _mm256_and_si256 (
+      _mm256_cmpgt_epi8 (__lower, _mm256_set1_epi8 ('a' - 1)),
+      _mm256_cmpgt_epi8 (_mm256_set1_epi8 ('f' + 1), __lower));
+  __bad |= ~static_cast<unsigned> (
+      _mm256_movemask_epi8 (_mm256_or_si256 (__digit, __alpha)));
+  __m256i __dv = _mm256_sub_epi8 (__c, _mm256_set1_epi8 ('0'));
+  __m256i __av = _mm256_sub_epi8 (__lower, _mm256_set1_epi8 ('a' - 10));
+  return _mm256_blendv_epi8 (__av, __dv, __digit);
+}
+
+__attribute__ ((target ("avx2"))) inline std::size_t
+__hex_decode_avx2 (const char *__in, std::size_t __n,
+                   std::uint8_t *__out) noexcept
+{
+  const __m256i __weights = _mm256_set1_epi16 (0x0110);
+  std::size_t __i = 0;
+  for (; __i + 32 <= __n; __i += 32)
+    {
+      unsigned __bad = 0;
+      __m256i __a = __hex_nibbles_avx2 (
+          _mm256_loadu_si256 (
+              reinterpret_cast<const __m256i *> (__in + 2 * __i)),
+          __bad);
+      __m256i __b = __hex_nibbles_avx2 (
+          _mm256_loadu_si256 (
+              reinterpret_cast<const __m256i *> (__in + 2 * __i + 32)),
+          __bad);
+      if (__bad != 0)
+        break;
+      // packus interleaves the lanes of its operands; undo that.
+      __m256i __bytes
+          = _mm256_packus_epi16 (_mm256_maddubs_epi16 (__a, __weights),
+                                 _mm256_maddubs_epi16 (__b, __weights));
+      _mm256_storeu_si256 (reinterpret_cast<__m256i *> (__out + __i),
+                           _mm256_permute4x64_epi64 (__bytes, 0xd8));
+    }
+  return __i + __hex_decode_ssse3 (__in + 2 * __i, __n - __i, __out + __i);
+}
+#endif
+
+typedef void (*_Hex_encode_fn) (const std::uint8_t *, std::size_t, char *);
+typedef std::size_t (*_Hex_decode_fn) (const char *, std::size_t,
+                                       std::uint8_t *);
+
+struct _Hex_kernels
+{
+  _Hex_encode_fn _M_encode;
+  _Hex_decode_fn _M_decode;
+};
+
+inline _Hex_kernels
+__hex_select_kernels () noexcept
+{
+  return cpu_select<_Hex_kernels> ({
+#ifdef __LIBBASIC_X86
+      { cpu_level::avx2, { __hex_encode_avx2, __hex_decode_avx2 } },
+      { cpu_level::ssse3, { __hex_encode_ssse3, __hex_decode_ssse3 } },
+#endif
+      { cpu_level::scalar, { __hex_encode_scalar, __hex_decode_scalar } },
+  });
+}
+
+inline const _Hex_kernels &
+__hex_kernels () noexcept
+{
+  static const _Hex_kernels __k = __hex_select_kernels ();
+  return __k;
+}
+
+}
+
+// Writes the 2 * __in.size () lowercase digits of __in to __out.
+inline void
+hex_encode (byte_view __in, char *__out) noexcept
+{
+  __detail::__hex_kernels ()._M_encode (
+      reinterpret_cast<const std::uint8_t *> (__in.data ()), __in.size (),
+      __out);
+}
+
+inline std::string
+to_hex (byte_view __in, bool __prefix = false)
+{
+  std::string __s (2 * __in.size () + (__prefix ? 2 : 0), '0');
+  if (__prefix)
+    __s[1] = 'x';
+  hex_encode (__in, __s.data () + (__prefix ? 2 : 0));
+  return __s;
+}
+
+// Decodes the digits of __in, with no "0x" prefix, into __out, which must
+// hold (__in.size () + 1) / 2 bytes or the call fails with
+// value_too_large.  An odd count of digits is taken as having an implicit
+// leading zero.  Digits of either case are accepted.
+inline hex_decode_result
+hex_decode (std::string_view __in, mutable_byte_view __out) noexcept
+{
+  const char *__p = __in.data ();
+  std::size_t __n = (__in.size () + 1) / 2;
+  if (__out.size () < __n)
+    return { __p, std::errc::value_too_large };
+  std::uint8_t *__o = reinterpret_cast<std::uint8_t *> (__out.data ());
+  if (__in.size () % 2 != 0)
+    {
+      std::uint8_t __v = __detail::__hex_values[std::uint8_t (*__p)];
+      if (__v == 0xff)
+        return { __p, std::errc::invalid_argument };
+      *__o++ = __v;
+      ++__p;
+      --__n;
+    }
+  std::size_t __done = __detail::__hex_kernels ()._M_decode (__p, __n, __o);
+  if (__done != __n)
+    {
+      const char *__bad = __p + 2 * __done;
+      if (__detail::__hex_values[std::uint8_t (*__bad)] != 0xff)
+        ++__bad;
+      return { __bad, std::errc::invalid_argument };
+    }
+  return { __in.data () + __in.size (), std::errc () };
+}
+
+} // namespace basic
+
+#endif //__LIBBASIC_HEX_H__
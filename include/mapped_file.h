@@ -0,0 +1,241 @@
+#ifndef __LIBBASIC_MAPPED_FILE_H__
+#define __LIBBASIC_MAPPED_FILE_H__
+
+#include "byte.h"
+#include "byte_view.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define __LIBBASIC_HAS_MMAP 1
+#endif
+
+#ifdef __LIBBASIC_HAS_MMAP
+
+namespace basic
+{
+
+// How the mapping will be read, passed on to madvise.
+enum class mapped_file_access
+{
+  normal,
+  sequential, // aggressive read-ahead, pages freed soon after use
+  random,     // no read-ahead
+};
+
+struct mapped_file_options
+{
+  mapped_file_access access = mapped_file_access::sequential;
+  // Start reading the whole file in the background right away.
+  bool willneed = false;
+  // Fault every page in before open returns (MAP_POPULATE).
+  bool populate = false;
+  // Ask for transparent huge pages, which only some file systems honour
+  // for file mappings; silently ignored elsewhere.
+  bool huge_pages = false;
+};
+
+// A read-only, private mapping of a whole file, exposed as a byte_view so
+// that decoders such as rlp_item_view walk the file in place without
+// reading it into memory first.  Move-only; unmaps on destruction.
+class mapped_file
+{
+public:
+  mapped_file () noexcept : _M_data (nullptr), _M_size (0) {}
+
+  // Throws std::system_error if the file cannot be opened or mapped.
+  explicit mapped_file (const std::filesystem::path &__path,
+                        const mapped_file_options &__options = {})
+      : mapped_file ()
+  {
+    if (std::error_code __ec = open (__path, __options))
+      throw std::system_error (__ec, "mapped_file: " + __path.string ());
+  }
+
+  mapped_file (mapped_file &&__x) noexcept
+      : _M_data (std::exchange (__x._M_data, nullptr)),
+        _M_size (std::exchange (__x._M_size, 0))
+  {
+  }
+
+  mapped_file &
+  operator= (mapped_file &&__x) noexcept
+  {
+    if (this != &__x)
+      {
+        close ();
+        _M_data = std::exchange (__x._M_data, nullptr);
+        _M_size = std::exchange (__x._M_size, 0);
+      }
+    return *this;
+  }
+
+  ~mapped_file () { close (); }
+
+  // Replaces the current mapping, if any.  An empty file maps to an open,
+  // empty view.
+  std::error_code
+  open (const std::filesystem::path &__path,
+        const mapped_file_options &__options = {}) noexcept
+  {
+    close ();
+    int __fd = ::open (__path.c_str (), O_RDONLY | O_CLOEXEC);
+    if (__fd < 0)
+      return _S_last_error ();
+    struct stat __st;
+    if (::fstat (__fd, &__st) != 0)
+      {
+        std::error_code __ec = _S_last_error ();
+        ::close (__fd);
+        return __ec;
+      }
+    std::size_t __size = static_cast<std::size_t> (__st.st_size);
+    if (__size == 0)
+      {
+        ::close (__fd);
+        _M_data = _S_empty ();
+        return {};
+      }
+    int __flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (__options.populate)
+      __flags |= MAP_POPULATE;
+#endif
+    void *__p = ::mmap (nullptr, __size, PROT_READ, __flags, __fd, 0);
+    // The mapping keeps the file referenced.
+    std::error_code __ec = __p == MAP_FAILED ? _S_last_error ()
+                                             : std::error_code ();
+    ::close (__fd);
+    if (__ec)
+      return __ec;
+    _M_data = static_cast<const byte *> (__p);
+    _M_size = __size;
+    _M_advise (__options);
+    return {};
+  }
+
+  void
+  close () noexcept
+  {
+    if (_M_size != 0)
+      ::munmap (const_cast<byte *> (_M_data), _M_size);
+    _M_data = nullptr;
+    _M_size = 0;
+  }
+
+  bool
+  is_open () const noexcept
+  {
+    return _M_data != nullptr;
+  }
+
+  const byte *
+  data () const noexcept
+  {
+    return _M_data;
+  }
+
+  std::size_t
+  size () const noexcept
+  {
+    return _M_size;
+  }
+
+  bool
+  empty () const noexcept
+  {
+    return _M_size == 0;
+  }
+
+  byte_view
+  as_byte_view () const noexcept
+  {
+    return byte_view (_M_data, _M_size);
+  }
+
+  // Starts reading [__offset, __offset + __n) ahead of use.
+  void
+  prefetch (std::size_t __offset, std::size_t __n) const noexcept
+  {
+    _M_advise_range (__offset, __n, MADV_WILLNEED);
+  }
+
+  // Drops the pages of [__offset, __offset + __n) from this process, e.g.
+  // once a sequential pass is past them; they are read again if touched.
+  void
+  evict (std::size_t __offset, std::size_t __n) const noexcept
+  {
+    _M_advise_range (__offset, __n, MADV_DONTNEED);
+  }
+
+private:
+  static std::error_code
+  _S_last_error () noexcept
+  {
+    return std::error_code (errno, std::system_category ());
+  }
+
+  // is_open distinguishes an empty file from no file by a non-null data.
+  static const byte *
+  _S_empty () noexcept
+  {
+    static const byte __empty{};
+    return &__empty;
+  }
+
+  // Hints are best effort; failures are ignored.
+  void
+  _M_advise (const mapped_file_options &__options) const noexcept
+  {
+    void *__p = const_cast<byte *> (_M_data);
+    switch (__options.access)
+      {
+      case mapped_file_access::sequential:
+        ::madvise (__p, _M_size, MADV_SEQUENTIAL);
+        break;
+      case mapped_file_access::random:
+        ::madvise (__p, _M_size, MADV_RANDOM);
+        break;
+      case mapped_file_access::normal:
+        break;
+      }
+    if (__options.willneed)
+      ::madvise (__p, _M_size, MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+    if (__options.huge_pages)
+      ::madvise (__p, _M_size, MADV_HUGEPAGE);
+#endif
+  }
+
+  // madvise wants a page-aligned start, so the range is widened down to
+  // the page holding __offset.
+  void
+  _M_advise_range (std::size_t __offset, std::size_t __n,
+                   int __advice) const noexcept
+  {
+    if (__offset >= _M_size || __n == 0)
+      return;
+    __n = std::min (__n, _M_size - __offset);
+    std::size_t __page = static_cast<std::size_t> (::sysconf (_SC_PAGESIZE));
+    std::size_t __start = __offset - __offset % __page;
+    ::madvise (const_cast<byte *> (_M_data) + __start,
+               __offset + __n - __start, __advice);
+  }
+
+  const byte *_M_data;
+  std::size_t _M_size;
+};
+
+} // namespace basic
+
+#endif // __LIBBASIC_HAS_MMAP
+
+#endif //__LIBBASIC_MAPPED_FILE_H__
@@ -0,0 +1,296 @@
+#ifndef __LIBBASIC_POOL_ALLOCATOR_H__
+#define __LIBBASIC_POOL_ALLOCATOR_H__
+
+#include "byte.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace basic
+{
+
+// Counters of the calling thread's cache.
+struct pool_stats
+{
+  std::uint64_t allocations;       // requests served from a size class
+  std::uint64_t deallocations;     // blocks given back to a size class
+  std::uint64_t refills;           // cache misses refilled from global lists
+  std::uint64_t flushes;           // overflowing caches drained to them
+  std::uint64_t large_allocations; // requests passed on to operator new
+};
+
+namespace __detail
+{
+
+// Power-of-two size classes from 16 bytes to 64 KiB.
+inline constexpr std::size_t __pool_min_shift = 4;
+inline constexpr std::size_t __pool_classes = 13;
+inline constexpr std::size_t __pool_max_size
+    = std::size_t (1) << (__pool_min_shift + __pool_classes - 1);
+// Blocks a thread keeps per class, and the number moved at once between a
+// thread and the global lists.
+inline constexpr std::size_t __pool_cache_limit = 128;
+inline constexpr std::size_t __pool_batch = 32;
+// New blocks are carved out of slabs of at least this size.
+inline constexpr std::size_t __pool_slab_size = 64 * 1024;
+
+constexpr std::size_t
+__pool_class (std::size_t __n) noexcept
+{
+  return __n <= (std::size_t (1) << __pool_min_shift)
+             ? 0
+             : std::bit_width (__n - 1) - __pool_min_shift;
+}
+
+constexpr std::size_t
+__pool_class_size (std::size_t __c) noexcept
+{
+  return std::size_t (1) << (__c + __pool_min_shift);
+}
+
+struct _Pool_block
+{
+  _Pool_block *_M_next;
+};
+
+// Shared lists behind a mutex, reached only in batches.  Slabs are never
+// returned to the system.
+class _Pool_global
+{
+public:
+  static _Pool_global &
+  _S_instance ()
+  {
+    // Leaked so that caches of threads outliving static destruction can
+    // still flush into it.
+    static _Pool_global *__global = new _Pool_global;
+    return *__global;
+  }
+
+  // Moves up to __pool_batch blocks of class __c onto __list and returns
+  // how many were moved.
+  std::size_t
+  _M_take (std::size_t __c, _Pool_block *&__list)
+  {
+    std::lock_guard<std::mutex> __lock (_M_mutex);
+    if (_M_free[__c] == nullptr)
+      _M_carve (__c);
+    std::size_t __n = 0;
+    while (__n != __pool_batch && _M_free[__c] != nullptr)
+      {
+        _Pool_block *__b = _M_free[__c];
+        _M_free[__c] = __b->_M_next;
+        __b->_M_next = __list;
+        __list = __b;
+        ++__n;
+      }
+    return __n;
+  }
+
+  // Prepends the chain [__first, __last] to the list of class __c.
+  void
+  _M_give (std::size_t __c, _Pool_block *__first, _Pool_block *__last)
+  {
+    std::lock_guard<std::mutex> __lock (_M_mutex);
+    __last->_M_next = _M_free[__c];
+    _M_free[__c] = __first;
+  }
+
+  std::size_t
+  _M_reserved () const noexcept
+  {
+    return _M_reserved_bytes.load (std::memory_order_relaxed);
+  }
+
+private:
+  void
+  _M_carve (std::size_t __c)
+  {
+    std::size_t __size = __pool_class_size (__c);
+    std::size_t __count
+        = std::max (__pool_slab_size / __size, std::size_t (1));
+    byte *__slab = static_cast<byte *> (::operator new (__size * __count));
+    _M_reserved_bytes.fetch_add (__size * __count, std::memory_order_relaxed);
+    for (std::size_t __i = __count; __i != 0; --__i)
+      {
+        byte *__p = __slab + (__i - 1) * __size;
+        _M_free[__c] = ::new (__p) _Pool_block{ _M_free[__c] };
+      }
+  }
+
+  std::mutex _M_mutex;
+  _Pool_block *_M_free[__pool_classes] = {};
+  std::atomic<std::size_t> _M_reserved_bytes{ 0 };
+};
+
+// Per-thread lists, used without any synchronization.
+struct _Pool_cache
+{
+  _Pool_block *_M_free[__pool_classes] = {};
+  std::size_t _M_count[__pool_classes] = {};
+  pool_stats _M_stats = {};
+
+  ~_Pool_cache ()
+  {
+    for (std::size_t __c = 0; __c != __pool_classes; ++__c)
+      _M_flush (__c, _M_count[__c]);
+  }
+
+  static _Pool_cache &
+  _S_local () noexcept
+  {
+    thread_local _Pool_cache __cache;
+    return __cache;
+  }
+
+  void *
+  _M_allocate (std::size_t __c)
+  {
+    if (_M_free[__c] == nullptr)
+      {
+        _M_count[__c]
+            += _Pool_global::_S_instance ()._M_take (__c, _M_free[__c]);
+        ++_M_stats.refills;
+      }
+    _Pool_block *__b = _M_free[__c];
+    _M_free[__c] = __b->_M_next;
+    --_M_count[__c];
+    ++_M_stats.allocations;
+    return __b;
+  }
+
+  void
+  _M_deallocate (void *__p, std::size_t __c) noexcept
+  {
+    _M_free[__c] = ::new (__p) _Pool_block{ _M_free[__c] };
+    ++_M_stats.deallocations;
+    if (++_M_count[__c] > __pool_cache_limit)
+      {
+        _M_flush (__c, __pool_batch);
+        ++_M_stats.flushes;
+      }
+  }
+
+  // Hands the first __n blocks of class __c to the global lists.
+  void
+  _M_flush (std::size_t __c, std::size_t __n) noexcept
+  {
+    if (__n == 0)
+      return;
+    _Pool_block *__first = _M_free[__c];
+    _Pool_block *__last = __first;
+    for (std::size_t __i = 1; __i != __n; ++__i)
+      __last = __last->_M_next;
+    _M_free[__c] = __last->_M_next;
+    _M_count[__c] -= __n;
+    _Pool_global::_S_instance ()._M_give (__c, __first, __last);
+  }
+};
+
+}
+
+// Thread-caching allocator for small, short-lived blocks.  Each thread keeps
+// free lists per size class and only touches the shared, locked lists to
+// refill or drain them a batch at a time.  Blocks may be freed on another
+// thread than the one that allocated them.
+class size_class_pool
+{
+public:
+  static void *
+  allocate (std::size_t __n)
+  {
+    if (__n > __detail::__pool_max_size)
+      {
+        ++__detail::_Pool_cache::_S_local ()._M_stats.large_allocations;
+        return ::operator new (__n);
+      }
+    return __detail::_Pool_cache::_S_local ()._M_allocate (
+        __detail::__pool_class (__n));
+  }
+
+  static void
+  deallocate (void *__p, std::size_t __n) noexcept
+  {
+    if (__n > __detail::__pool_max_size)
+      ::operator delete (__p);
+    else
+      __detail::_Pool_cache::_S_local ()._M_deallocate (
+          __p, __detail::__pool_class (__n));
+  }
+
+  static pool_stats
+  thread_stats () noexcept
+  {
+    return __detail::_Pool_cache::_S_local ()._M_stats;
+  }
+
+  // Bytes obtained from operator new for the size classes so far.
+  static std::size_t
+  reserved_bytes () noexcept
+  {
+    return __detail::_Pool_global::_S_instance ()._M_reserved ();
+  }
+};
+
+// A stateless allocator drawing from size_class_pool.  Over-aligned types
+// bypass the pool.
+template <typename _Tp> class pool_allocator
+{
+public:
+  typedef _Tp value_type;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef std::true_type is_always_equal;
+  typedef std::true_type propagate_on_container_move_assignment;
+
+  constexpr pool_allocator () noexcept = default;
+
+  template <typename _Up>
+  constexpr pool_allocator (const pool_allocator<_Up> &) noexcept
+  {
+  }
+
+  [[nodiscard]] _Tp *
+  allocate (std::size_t __n)
+  {
+    if (__n > std::size_t (-1) / sizeof (_Tp))
+      throw std::bad_array_new_length ();
+    if constexpr (alignof (_Tp) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+      return static_cast<_Tp *> (::operator new (
+          __n * sizeof (_Tp), std::align_val_t (alignof (_Tp))));
+    else
+      return static_cast<_Tp *> (
+          size_class_pool::allocate (__n * sizeof (_Tp)));
+  }
+
+  void
+  deallocate (_Tp *__p, std::size_t __n) noexcept
+  {
+    if constexpr (alignof (_Tp) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+      ::operator delete (__p, std::align_val_t (alignof (_Tp)));
+    else
+      size_class_pool::deallocate (__p, __n * sizeof (_Tp));
+  }
+
+  template <typename _Up>
+  friend constexpr bool
+  operator== (const pool_allocator &, const pool_allocator<_Up> &) noexcept
+  {
+    return true;
+  }
+};
+
+namespace pooled
+{
+using bytes = std::vector<byte, pool_allocator<byte> >;
+}
+
+} // namespace basic
+
+#endif //__LIBBASIC_POOL_ALLOCATOR_H__
@@ -2,8 +2,28 @@
 #define __LIBBASIC_RLP_H__
 
 #include "bigint.h"
+#include "byte_view.h"
 #include "bytes.h"
+#include "hex.h"
+#include "rlp_error.h"
+#include "type_traits.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <memory_resource>
+#include <tuple>
+#include <typeinfo>
+#include <utility>
+#include <vector>
 
 namespace basic
 {
@@ -11,24 +31,64 @@ namespace basic
 namespace __detail
 {
 
+// The decoder is instantiated with narrow character types as well as
+// std::byte, which has no arithmetic; every prefix test goes through here.
+template <typename _Byte>
+constexpr std::uint8_t
+__rlp_octet (_Byte __b) noexcept
+{
+  return static_cast<std::uint8_t> (__b);
+}
+
 template <typename _Tp>
 requires std::is_unsigned_v<_Tp> constexpr std::size_t
 __unsigned_to_bytes_len (_Tp __val)
 {
-  std::size_t __n = 0;
-  for (; __val != 0; __val >>= 8)
-    ++__n;
-  return __n;
+  if constexpr (sizeof (_Tp) <= sizeof (std::uint64_t))
+    return (std::bit_width (static_cast<std::uint64_t> (__val)) + 7) / 8;
+  else
+    {
+      std::size_t __n = 0;
+      for (; __val != 0; __val >>= 8)
+        ++__n;
+      return __n;
+    }
 }
 
-template <typename _Tp, typename _Bytes>
-requires std::is_unsigned_v<_Tp> constexpr void
-__unsigned_to_bytes (_Tp __val, _Bytes &__result)
+// Stores the low __n bytes of __val at __out, most significant first.
+inline void
+__store_be (void *__out, std::uint64_t __val, std::size_t __n) noexcept
+{
+  assert (__n >= 1 && __n <= 8);
+  __val <<= 8 * (8 - __n);
+  if constexpr (std::endian::native == std::endian::little)
+    __val = __builtin_bswap64 (__val);
+  std::memcpy (__out, &__val, __n);
+}
+
+// The magnitude limbs of a cpp_int backed number, least significant first.
+template <typename _Tp>
+using __limb_type = std::remove_cvref_t<
+    decltype (*std::declval<const _Tp &> ().backend ().limbs ())>;
+
+template <typename _Tp>
+inline constexpr bool __has_wide_limbs
+    = sizeof (__limb_type<_Tp>) >= sizeof (std::uint64_t);
+
+// The __i-th 64-bit word of the magnitude of __val.
+template <typename _Tp>
+requires __has_wide_limbs<_Tp> constexpr std::uint64_t
+__number_word (const _Tp &__val, std::size_t __i) noexcept
 {
-  std::size_t __n = __unsigned_to_bytes_len (__val);
-  __result.resize (__n);
-  for (; __n > 0 && __val != 0; --__n, __val >>= 8)
-    __result[__n - 1] = __val & 0xff;
+  typedef __limb_type<_Tp> _Limb;
+  constexpr std::size_t __words_per_limb
+      = sizeof (_Limb) / sizeof (std::uint64_t);
+  std::size_t __limb = __i / __words_per_limb;
+  if (__limb >= __val.backend ().size ())
+    return 0;
+  return static_cast<std::uint64_t> (
+      __val.backend ().limbs ()[__limb]
+      >> (64 * (__i % __words_per_limb)));
 }
 
 template <typename _Bytes, typename _Tp>
@@ -37,10 +97,116 @@ __bytes_to_unsigned (const _Bytes &__bytes, _Tp &__result)
 {
   __result = 0;
   for (std::size_t __i = 0; __i < __bytes.size (); ++__i)
-    __result = ((__result << 8) | __bytes[__i]);
+    __result = ((__result << 8) | __rlp_octet (__bytes[__i]));
+}
+
+// Loads __n big-endian bytes from __in; the inverse of __store_be.
+inline std::uint64_t
+__load_be (const void *__in, std::size_t __n) noexcept
+{
+  assert (__n <= 8);
+  if (__n == 0)
+    return 0;
+  std::uint64_t __val = 0;
+  std::memcpy (&__val, __in, __n);
+  if constexpr (std::endian::native == std::endian::little)
+    __val = __builtin_bswap64 (__val);
+  return __val >> 8 * (8 - __n);
 }
+
+struct _Rlp_header
+{
+  std::size_t _M_offset; // header size
+  std::size_t _M_length; // payload size
+  bool _M_list;
+};
+
+// Decodes the header at __p, checking it against the __n bytes available
+// and the canonical-encoding rules.  On success the whole item, header and
+// payload, is known to lie within [__p, __p + __n).
+inline rlp_errc
+__rlp_parse_header (const std::uint8_t *__p, std::size_t __n,
+                    _Rlp_header &__h) noexcept
+{
+  if (__n == 0)
+    return rlp_errc::truncated;
+  std::uint8_t __prefix = __p[0];
+  __h._M_list = __prefix >= 0xc0;
+  if (__prefix < 0x80)
+    {
+      __h._M_offset = 0;
+      __h._M_length = 1;
+      return rlp_errc ();
+    }
+  std::uint8_t __base = __h._M_list ? 0xc0 : 0x80;
+  if (__prefix - __base < 56)
+    {
+      __h._M_offset = 1;
+      __h._M_length = __prefix - __base;
+      if (__h._M_length >= __n)
+        return rlp_errc::truncated;
+      if (!__h._M_list && __h._M_length == 1 && __p[1] < 0x80)
+        return rlp_errc::non_canonical_single_byte;
+      return rlp_errc ();
+    }
+  std::size_t __lenlen = __prefix - __base - 55;
+  if (__lenlen >= __n)
+    return rlp_errc::truncated;
+  if (__p[1] == 0)
+    return rlp_errc::non_canonical_size;
+  __h._M_offset = 1 + __lenlen;
+  __h._M_length = __load_be (__p + 1, __lenlen);
+  if (__h._M_length < 56)
+    return rlp_errc::non_canonical_size;
+  if (__h._M_length > __n - __h._M_offset)
+    return rlp_errc::truncated;
+  return rlp_errc ();
 }
 
+// Rebuilds the magnitude of __val from __n big-endian bytes, filling the
+// limbs a 64-bit word at a time.  Returns false if __val cannot hold them.
+template <typename _Tp>
+bool
+__number_from_be (_Tp &__val, const std::uint8_t *__in, std::size_t __n)
+{
+  if constexpr (std::numeric_limits<_Tp>::is_bounded)
+    if (__n * 8 > static_cast<std::size_t> (std::numeric_limits<_Tp>::digits)
+                      + 7)
+      return false;
+
+  __val = 0;
+  if constexpr (__has_wide_limbs<_Tp>)
+    {
+      typedef __limb_type<_Tp> _Limb;
+      constexpr std::size_t __words_per_limb
+          = sizeof (_Limb) / sizeof (std::uint64_t);
+      std::size_t __words = (__n + 7) / 8;
+      std::size_t __limbs = (__words + __words_per_limb - 1) / __words_per_limb;
+      if (__limbs == 0)
+        return true;
+      __val.backend ().resize (__limbs, __limbs);
+      if (__val.backend ().size () < __limbs)
+        return false;
+      _Limb *__out = __val.backend ().limbs ();
+      std::fill_n (__out, __limbs, _Limb (0));
+      for (std::size_t __i = 0; __i < __words; ++__i)
+        {
+          std::size_t __last = __n - 8 * __i;
+          std::size_t __len = std::min<std::size_t> (__last, 8);
+          __out[__i / __words_per_limb]
+              |= static_cast<_Limb> (__load_be (__in + __last - __len, __len))
+                 << (64 * (__i % __words_per_limb));
+        }
+      __val.backend ().normalize ();
+    }
+  else
+    boost::multiprecision::import_bits (__val, __in, __in + __n, 8);
+  return true;
+}
+}
+
+template <typename _Byte> class rlp_item_view;
+
 template <typename _Byte> class rlp_item 
   : private std::span<_Byte>
 {
@@ -88,34 +254,63 @@ public:
     return _M_position ().first;
   }
 
-  std::span<value_type>
+  // Throws std::bad_cast if the header claims more bytes than the item
+  // holds.
+  std::span<_Byte>
   payload () const
   {
     if (empty ())
       return {};
+    _S_checked_item_size (_Base::data (), _Base::size ());
     std::pair<size_type, size_type> __pos = _M_position ();
     iterator __iter = _Base::begin ();
-    return std::span<value_type>{ __iter + __pos.first,
-                                  __iter + __pos.first + __pos.second };
+    return std::span<_Byte>{ __iter + __pos.first,
+                             __iter + __pos.first + __pos.second };
   }
 
   size_type
   items_size () const
   {
-    return _M_split_list ().size ();
+    size_type __n = 0;
+    if (_M_is_list ())
+      {
+        std::span<_Byte> __payload = payload ();
+        const_pointer __ptr = __payload.data ();
+        const_pointer __last = __ptr + __payload.size ();
+        for (; __ptr != __last; ++__n)
+          __ptr += _S_checked_item_size (__ptr, __last - __ptr);
+      }
+    return __n;
   }
 
+  // Walks past the preceding siblings without allocating; callers doing
+  // repeated random access should build an rlp_list_index once instead.
   rlp_item
   sub_item (size_type __i) const
   {
-    std::vector<std::pair<iterator, size_type> > __items = _M_split_list ();
-    std::size_t __n = __items.size ();
-    if (__i >= __n)
+    if (_M_is_list ())
       {
-        throw std::bad_cast ();
+        std::span<_Byte> __payload = payload ();
+        pointer __ptr = __payload.data ();
+        pointer __last = __ptr + __payload.size ();
+        for (; __ptr != __last; --__i)
+          {
+            size_type __offlen = _S_checked_item_size (__ptr, __last - __ptr);
+            if (__i == 0)
+              return rlp_item (__ptr, __offlen);
+            __ptr += __offlen;
+          }
       }
-    const std::pair<iterator, value_type> &__sub_item = __items[__i];
-    return rlp_item (__sub_item.first, __sub_item.second);
+    throw std::bad_cast ();
+  }
+
+  // The children of a list, walked in place; empty for a string item.
+  rlp_item_view<_Byte>
+  children () const
+  {
+    if (!_M_is_list ())
+      return {};
+    return rlp_item_view<_Byte> (payload ());
   }
 
   bool
@@ -124,10 +319,13 @@ public:
     return _M_is_list ();
   }
 
+  // Orders items by their encoded bytes, so equal items need not share
+  // storage.
   int
-  compare (const rlp_item &__x) const
+  compare (const rlp_item &__x) const noexcept
   {
-    return data () == __x.data () && size () == __x.size ();
+    return byte_view (data (), size ()).compare (
+        byte_view (__x.data (), __x.size ()));
   }
 
   template <typename _Tp>
@@ -144,19 +342,55 @@ private:
   void
   _M_to_value (_Range &__result) const
   {
+    constexpr bool __byte_string
+        = is_underlying_byte_v<range_iter_value_type<_Range> >
+          && std::ranges::contiguous_range<_Range>
+          && std::ranges::sized_range<_Range>;
+    constexpr bool __decodable_elements
+        = requires (const rlp_item &__item,
+                    std::ranges::range_reference_t<_Range> __elem) {
+            __item._M_to_value (__elem);
+          };
+    static_assert (__byte_string || __decodable_elements,
+                   "range element type has no RLP decoding");
     if (!_M_is_list ())
       {
+        // A string decodes into a container of bytes as its payload; one
+        // that cannot be resized must already have the payload's size.
+        if constexpr (__byte_string)
+          {
+            std::span<_Byte> __payload = payload ();
+            if constexpr (requires { __result.resize (size_type ()); })
+              __result.resize (__payload.size ());
+            else if (std::ranges::size (__result) != __payload.size ())
+              throw std::bad_cast ();
+            if (!__payload.empty ())
+              std::memcpy (std::ranges::data (__result), __payload.data (),
+                           __payload.size ());
+            return;
+          }
         throw std::bad_cast ();
       }
-    std::vector<std::pair<iterator, value_type> > __items = _M_split_list ();
-    typename _Range::iterator __begin = std::ranges::begin (__result),
-                              __end = std::ranges::end (__result);
-    for (std::size_t __i = 0; __i < __items.size () && __begin != __end;
-         ++__i, ++__begin)
+    if constexpr (__decodable_elements)
       {
-        sub_item (__i).template to_value<std::ranges::range_value_t<_Range> > (
-            *__begin);
+        if constexpr (requires { __result.resize (size_type ()); })
+          __result.resize (items_size ());
+
+        std::span<_Byte> __payload = payload ();
+        pointer __ptr = __payload.data ();
+        pointer __last = __ptr + __payload.size ();
+        std::ranges::iterator_t<_Range> __begin
+            = std::ranges::begin (__result);
+        std::ranges::sentinel_t<_Range> __end = std::ranges::end (__result);
+        for (; __ptr != __last && __begin != __end; ++__begin)
+          {
+            size_type __offlen = _S_checked_item_size (__ptr, __last - __ptr);
+            rlp_item (__ptr, __offlen)._M_to_value (*__begin);
+            __ptr += __offlen;
+          }
       }
+    else
+      throw std::bad_cast ();
   }
 
   template <typename _Tp>
@@ -171,12 +405,28 @@ private:
 
     if (!_M_is_list ())
       {
-        std::span<value_type> __payload = payload ();
+        std::span<_Byte> __payload = payload ();
+        const std::uint8_t *__ptr
+            = reinterpret_cast<const std::uint8_t *> (__payload.data ());
+        std::size_t __n = __payload.size ();
+        // Integers are minimal: no leading zero byte, and a value below
+        // 0x80 is its own encoding rather than a one byte string, whose
+        // payload would start after a header.
+        if ((__n != 0 && __ptr[0] == 0)
+            || (__n == 1 && __payload.data () != _Base::data ()
+                && __ptr[0] < 0x80))
+          throw std::bad_cast ();
         if constexpr (std::is_unsigned_v<_Tp>)
-          __detail::__bytes_to_unsigned (__payload, __result);
-        else
-          boost::multiprecision::import_bits (__result, __payload.begin (),
-                                              __payload.end (), 8);
+          {
+            if (__n > sizeof (_Tp))
+              throw std::bad_cast ();
+            if constexpr (sizeof (_Tp) <= sizeof (std::uint64_t))
+              __result = static_cast<_Tp> (__detail::__load_be (__ptr, __n));
+            else
+              __detail::__bytes_to_unsigned (__payload, __result);
+          }
+        else if (!__detail::__number_from_be (__result, __ptr, __n))
+          throw std::bad_cast ();
       }
     else
       {
@@ -191,51 +441,56 @@ private:
       {
         throw std::bad_cast ();
       }
-    __str.clear ();
-    std::span<value_type> __payload = payload ();
-    __str.assign (__payload.begin (), __payload.begin () + length ());
+    std::span<_Byte> __payload = payload ();
+    __str.assign (reinterpret_cast<const char *> (__payload.data ()),
+                  __payload.size ());
   }
 
   bool
   _M_is_list () const noexcept
   {
-    return !empty () && _Base::front () >= 0xc0;
+    return !empty () && __detail::__rlp_octet (_Base::front ()) >= 0xc0;
   }
 
-  std::vector<std::pair<iterator, size_type> >
-  _M_split_list () const
+  std::pair<size_type, size_type>
+  _M_position () const
   {
-    std::vector<std::pair<iterator, size_type> > __result;
-    if (_M_is_list ())
-      {
-        std::span<value_type> __payload = payload ();
-        size_type __n = __payload.size ();
-        while (__n != 0 && __n >= __payload.size ())
-          {
-            std::pair<size_type, size_type> __pos
-                = _M_position (__payload.data (), __payload.size ());
-            std::size_t __offlen = __pos.first + __pos.second;
-            __result.push_back (std::make_pair (__payload.begin (), __offlen));
-            __payload = std::span<value_type>{ __payload.begin () + __offlen,
-                                               __payload.end () };
-            __n -= __offlen;
-          }
-      }
-    return __result;
+    return _S_position (_Base::data (), _Base::size ());
   }
 
-  std::pair<size_type, size_type>
-  _M_position () const
+  // Total encoded size (header and payload) of the item starting at __ptr.
+  // Throws std::bad_cast unless the item lies within the __size bytes
+  // available, so that walking a malformed list can never step past its
+  // end whether or not assertions are enabled.
+  static size_type
+  _S_checked_item_size (const_pointer __ptr, size_type __size)
   {
-    return _M_position (_Base::data (), _Base::size ());
+    if (__size == 0)
+      throw std::bad_cast ();
+    std::uint8_t __prefix = __detail::__rlp_octet (*__ptr);
+    if (__prefix < 0x80)
+      return 1;
+    std::uint8_t __base = __prefix >= 0xc0 ? 0xc0 : 0x80;
+    size_type __header = 1;
+    size_type __length = __prefix - __base;
+    if (__length >= 56)
+      {
+        __header += __length - 55;
+        if (__header > __size)
+          throw std::bad_cast ();
+        __length = __detail::__load_be (__ptr + 1, __header - 1);
+      }
+    if (__header > __size || __length > __size - __header)
+      throw std::bad_cast ();
+    return __header + __length;
   }
 
-  std::pair<size_type, size_type>
-  _M_position (const_pointer __ptr, size_type __size) const
+  static std::pair<size_type, size_type>
+  _S_position (const_pointer __ptr, size_type __size)
   {
     if (__size == 0)
       return std::make_pair (0, 0);
-    _Byte __prefix = *__ptr;
+    std::uint8_t __prefix = __detail::__rlp_octet (*__ptr);
     if (__prefix < 0x80)
       return std::make_pair (0, 1);
     if (__prefix <= 0xb7)
@@ -248,10 +503,7 @@ private:
       {
         std::size_t __nstrlen = __prefix - 0xb7;
         assert (__size > __nstrlen);
-        std::size_t __strlen;
-        __detail::__bytes_to_unsigned (
-            std::span<const _Byte> (__ptr + 1, __ptr + 1 + __nstrlen),
-            __strlen);
+        std::size_t __strlen = __detail::__load_be (__ptr + 1, __nstrlen);
         assert (__size > __nstrlen + __strlen);
         return std::make_pair (1 + __nstrlen, __strlen);
       }
@@ -261,20 +513,16 @@ private:
         assert (__size > __nstrlen);
         return std::make_pair (1, __nstrlen);
       }
-    if (__prefix <= 0xff)
-      {
-        std::size_t __nstrlen = __prefix - 0xf7;
-        assert (__size > __nstrlen);
-        std::size_t __strlen;
-        __detail::__bytes_to_unsigned (
-            std::span<const _Byte> (__ptr + 1, __ptr + 1 + __nstrlen),
-            __strlen);
-        assert (__size > __nstrlen + __strlen);
-        return std::make_pair (1 + __nstrlen, __strlen);
-      }
+    std::size_t __nstrlen = __prefix - 0xf7;
+    assert (__size > __nstrlen);
+    std::size_t __strlen = __detail::__load_be (__ptr + 1, __nstrlen);
+    assert (__size > __nstrlen + __strlen);
+    return std::make_pair (1 + __nstrlen, __strlen);
   }
 
   template <typename> friend class rlp_item_iterator;
+  template <typename> friend class rlp_item_view;
+  template <typename, std::size_t> friend class rlp_list_index;
 };
 
 template <typename _Byte>
@@ -291,8 +539,276 @@ operator!= (const rlp_item<_Byte> &__x, const rlp_item<_Byte> &__y)
   return __x.compare (__y) != 0;
 }
 
+template <typename _Byte>
+inline std::strong_ordering
+operator<=> (const rlp_item<_Byte> &__x, const rlp_item<_Byte> &__y)
+{
+  return __x.compare (__y) <=> 0;
+}
+
+// A forward view over a run of concatenated RLP items, such as the payload
+// of a list or a stream of top-level items.  Iteration only bumps pointers
+// over the encoded bytes; nothing is copied or allocated.
+template <typename _Byte>
+class rlp_item_view : public std::ranges::view_interface<rlp_item_view<_Byte> >
+{
+  typedef rlp_item<_Byte> _Rlp_item_type;
+
+  class _Iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_concept;
+    typedef std::input_iterator_tag iterator_category;
+    typedef _Rlp_item_type value_type;
+    typedef std::ptrdiff_t difference_type;
+
+    _Iterator () = default;
+
+    _Iterator (_Byte *__first, _Byte *__last)
+        : _M_cur (__first), _M_next (__first), _M_end (__last)
+    {
+      _M_advance ();
+    }
+
+    value_type
+    operator* () const
+    {
+      return value_type (_M_cur, _M_next - _M_cur);
+    }
+
+    _Iterator &
+    operator++ ()
+    {
+      _M_cur = _M_next;
+      _M_advance ();
+      return *this;
+    }
+
+    _Iterator
+    operator++ (int)
+    {
+      _Iterator __tmp = *this;
+      ++*this;
+      return __tmp;
+    }
+
+    friend bool
+    operator== (const _Iterator &__x, const _Iterator &__y) noexcept
+    {
+      return __x._M_cur == __y._M_cur;
+    }
+
+    friend bool
+    operator== (const _Iterator &__x, std::default_sentinel_t) noexcept
+    {
+      return __x._M_cur == __x._M_end;
+    }
+
+  private:
+    // Throws std::bad_cast if the child runs past the payload, so that
+    // _M_next never skips over _M_end.
+    void
+    _M_advance ()
+    {
+      if (_M_cur != _M_end)
+        _M_next = _M_cur
+                  + _Rlp_item_type::_S_checked_item_size (_M_cur,
+                                                          _M_end - _M_cur);
+    }
+
+    _Byte *_M_cur = nullptr;
+    _Byte *_M_next = nullptr;
+    _Byte *_M_end = nullptr;
+  };
+
+public:
+  rlp_item_view () = default;
+
+  explicit rlp_item_view (std::span<_Byte> __bytes) noexcept
+      : _M_first (__bytes.data ()), _M_last (__bytes.data () + __bytes.size ())
+  {
+  }
+
+  rlp_item_view (_Byte *__ptr, std::size_t __n) noexcept
+      : _M_first (__ptr), _M_last (__ptr + __n)
+  {
+  }
+
+  _Iterator
+  begin () const
+  {
+    return _Iterator (_M_first, _M_last);
+  }
+
+  std::default_sentinel_t
+  end () const noexcept
+  {
+    return std::default_sentinel;
+  }
+
+  bool
+  empty () const noexcept
+  {
+    return _M_first == _M_last;
+  }
+
+private:
+  _Byte *_M_first = nullptr;
+  _Byte *_M_last = nullptr;
+};
+
+template <typename _Byte>
+rlp_item_view (std::span<_Byte>) -> rlp_item_view<_Byte>;
+
+// Offsets of the children of an RLP list, built in a single pass over the
+// payload.  Child __i spans [_M_offsets[__i], _M_offsets[__i + 1]) relative
+// to the payload, so random access and size () are constant time.  The
+// offsets live in inline storage for up to _Nm children, or in a
+// caller-provided arena; only when both are exhausted does the index spill to
+// the heap, and a spilled index keeps its storage across build () calls.
+template <typename _Byte, std::size_t _Nm = 16> class rlp_list_index
+{
+  typedef rlp_item<_Byte> _Rlp_item_type;
+
+public:
+  typedef _Rlp_item_type value_type;
+  typedef std::size_t size_type;
+
+public:
+  rlp_list_index () noexcept : _M_payload (), _M_size (0), _M_arena () {}
+
+  explicit rlp_list_index (std::span<size_type> __arena) noexcept
+      : _M_payload (), _M_size (0), _M_arena (__arena)
+  {
+  }
+
+  explicit rlp_list_index (const _Rlp_item_type &__list) : rlp_list_index ()
+  {
+    build (__list);
+  }
+
+  rlp_list_index (const _Rlp_item_type &__list,
+                  std::span<size_type> __arena)
+      : rlp_list_index (__arena)
+  {
+    build (__list);
+  }
+
+  void
+  build (const _Rlp_item_type &__list)
+  {
+    if (!__list.is_list ())
+      throw std::bad_cast ();
+
+    std::span<_Byte> __payload = __list.payload ();
+    _M_payload = __payload.data ();
+    _M_size = 0;
+
+    size_type *__offsets = _M_storage ();
+    size_type __capacity = _M_capacity ();
+    size_type __off = 0, __n = __payload.size ();
+    for (;;)
+      {
+        if (_M_size == __capacity)
+          {
+            __offsets = _M_grow ();
+            __capacity = _M_capacity ();
+          }
+        __offsets[_M_size] = __off;
+        if (__off == __n)
+          break;
+        __off += _Rlp_item_type::_S_checked_item_size (_M_payload + __off,
+                                                       __n - __off);
+        ++_M_size;
+      }
+  }
+
+  void
+  clear () noexcept
+  {
+    _M_payload = nullptr;
+    _M_size = 0;
+  }
+
+  size_type
+  size () const noexcept
+  {
+    return _M_size;
+  }
+
+  bool
+  empty () const noexcept
+  {
+    return _M_size == 0;
+  }
+
+  value_type
+  operator[] (size_type __i) const noexcept
+  {
+    const size_type *__offsets = _M_storage ();
+    return value_type (_M_payload + __offsets[__i],
+                       __offsets[__i + 1] - __offsets[__i]);
+  }
+
+  value_type
+  at (size_type __i) const
+  {
+    if (__i >= _M_size)
+      throw std::out_of_range ("rlp_list_index::at");
+    return (*this)[__i];
+  }
+
+private:
+  size_type *
+  _M_storage () noexcept
+  {
+    if (!_M_spill.empty ())
+      return _M_spill.data ();
+    if (!_M_arena.empty ())
+      return _M_arena.data ();
+    return _M_inline.data ();
+  }
+
+  const size_type *
+  _M_storage () const noexcept
+  {
+    return const_cast<rlp_list_index *> (this)->_M_storage ();
+  }
+
+  size_type
+  _M_capacity () const noexcept
+  {
+    if (!_M_spill.empty ())
+      return _M_spill.size ();
+    if (!_M_arena.empty ())
+      return _M_arena.size ();
+    return _M_inline.size ();
+  }
+
+  size_type *
+  _M_grow ()
+  {
+    size_type __capacity = _M_capacity ();
+    if (_M_spill.empty ())
+      {
+        std::vector<size_type> __spill (__capacity * 2);
+        std::copy_n (_M_storage (), _M_size, __spill.begin ());
+        _M_spill.swap (__spill);
+      }
+    else
+      _M_spill.resize (__capacity * 2);
+    return _M_spill.data ();
+  }
+
+  _Byte *_M_payload;
+  size_type _M_size;
+  std::span<size_type> _M_arena;
+  std::array<size_type, _Nm + 1> _M_inline;
+  std::vector<size_type> _M_spill;
+};
+
 template <typename _Byte = byte>
-class rlp_item_iterator 
+class rlp_item_iterator
   : private std::span<_Byte>
 {
   typedef std::span<_Byte> _Base;
@@ -305,100 +821,899 @@ public:
   typedef const value_type *pointer;
   typedef const value_type &reference;
 
-public:
-  template <typename... _Args>
-  rlp_item_iterator (_Args &&...__args)
-      : _Base (std::forward<_Args> (__args)...), _M_value ()
+public:
+  template <typename... _Args>
+  requires std::is_constructible_v<_Base, _Args...>
+  rlp_item_iterator (_Args &&...__args)
+      : _Base (std::forward<_Args> (__args)...), _M_value ()
+  {
+    _M_iter = _Base::begin ();
+    _M_next ();
+  }
+
+  rlp_item_iterator (const _Rlp_item_type &__item)
+      : _Base (__item.begin (), __item.end ()), _M_value ()
+  {
+    _M_iter = _Base::begin ();
+    _M_next ();
+  }
+
+  rlp_item_iterator &operator= (const rlp_item_iterator &) = default;
+  ~rlp_item_iterator () = default;
+
+  const value_type &
+  operator* () const
+  {
+    return _M_value;
+  }
+
+  const value_type *
+  operator->() const
+  {
+    return std::addressof (_M_value);
+  }
+
+  rlp_item_iterator &
+  operator++ ()
+  {
+    _M_next ();
+    return *this;
+  }
+
+  rlp_item_iterator
+  operator++ (int)
+  {
+    rlp_item_iterator __tmp = *this;
+    ++*this;
+    return __tmp;
+  }
+
+private:
+  void
+  _M_next ()
+  {
+    typename _Base::iterator __end = _Base::end ();
+    if (_M_iter != __end)
+      {
+        std::size_t __offlen = _Rlp_item_type::_S_checked_item_size (
+            std::to_address (_M_iter), __end - _M_iter);
+        _M_value = _Rlp_item_type (_M_iter, _M_iter + __offlen);
+        _M_iter += __offlen;
+      }
+    else
+      {
+        _M_done = true;
+      }
+  }
+
+public:
+  bool
+  _M_equal (const rlp_item_iterator &__x) const
+  {
+    if (_M_done && __x._M_done)
+      return true;
+    return _Base::data () == __x.data () && _Base::size () == __x.size ()
+           && _M_iter == __x._M_iter && _M_value == __x._M_value;
+  }
+
+  friend bool
+  operator== (const rlp_item_iterator &__x, const rlp_item_iterator &__y)
+  {
+    return __x._M_equal (__y);
+  }
+
+  friend bool
+  operator!= (const rlp_item_iterator &__x, const rlp_item_iterator &__y)
+  {
+    return !__x._M_equal (__y);
+  }
+
+private:
+  _Rlp_item_type _M_value;
+  typename _Base::iterator _M_iter;
+  bool _M_done = false;
+};
+
+inline constexpr std::size_t rlp_default_max_depth = 64;
+
+// The outcome of rlp_validate, in the manner of std::from_chars_result:
+// offset is where the offending item starts, or the input size on success.
+struct rlp_validate_result
+{
+  std::size_t offset;
+  std::error_code ec;
+
+  explicit operator bool () const noexcept
+  {
+    return !ec;
+  }
+};
+
+namespace __detail
+{
+inline rlp_errc
+__rlp_validate (const std::uint8_t *&__ptr, const std::uint8_t *__last,
+                std::size_t __depth, bool __nested) noexcept
+{
+  while (__ptr != __last)
+    {
+      _Rlp_header __h;
+      rlp_errc __e = __rlp_parse_header (__ptr, __last - __ptr, __h);
+      if (__e != rlp_errc ())
+        return __e == rlp_errc::truncated && __nested ? rlp_errc::overrun
+                                                       : __e;
+      if (!__h._M_list)
+        {
+          __ptr += __h._M_offset + __h._M_length;
+          continue;
+        }
+      if (__depth == 0)
+        return rlp_errc::depth_exceeded;
+      const std::uint8_t *__end = __ptr + __h._M_offset + __h._M_length;
+      __ptr += __h._M_offset;
+      __e = __rlp_validate (__ptr, __end, __depth - 1, true);
+      if (__e != rlp_errc ())
+        return __e;
+    }
+  return rlp_errc ();
+}
+}
+
+// Checks in one linear pass that __bytes is a sequence of well-formed,
+// canonically encoded RLP items nested at most __max_depth lists deep.
+// Nothing throws; once this succeeds, rlp_item accessors over the same bytes
+// cannot run out of bounds, so their checks may be compiled out.
+inline rlp_validate_result
+rlp_validate (byte_view __bytes,
+              std::size_t __max_depth = rlp_default_max_depth) noexcept
+{
+  const std::uint8_t *__first
+      = reinterpret_cast<const std::uint8_t *> (__bytes.data ());
+  const std::uint8_t *__last = __first + __bytes.size ();
+  const std::uint8_t *__ptr = __first;
+  rlp_errc __e = __detail::__rlp_validate (__ptr, __last, __max_depth, false);
+  if (__e != rlp_errc ())
+    return { static_cast<std::size_t> (__ptr - __first), __e };
+  return { __bytes.size (), std::error_code () };
+}
+
+// Describes the RLP layout of a struct as the list of its fields, in
+// order, by specializing rlp_schema with a tuple of member pointers:
+//
+//   template <> struct basic::rlp_schema<legacy_tx>
+//   {
+//     static constexpr auto fields = std::tuple (
+//         &legacy_tx::nonce, &legacy_tx::gas_price, &legacy_tx::gas,
+//         &legacy_tx::to, &legacy_tx::value, &legacy_tx::data);
+//   };
+template <typename _Tp> struct rlp_schema;
+
+template <typename _Tp>
+concept rlp_described = requires {
+  std::tuple_size<
+      std::remove_cvref_t<decltype (rlp_schema<_Tp>::fields)> >::value;
+};
+
+namespace __detail
+{
+
+template <typename _Tp>
+inline constexpr std::size_t __rlp_field_count = std::tuple_size_v<
+    std::remove_cvref_t<decltype (rlp_schema<_Tp>::fields)> >;
+
+// Calls __f on every field of __val in schema order.
+template <typename _Tp, typename _Fn>
+constexpr void
+__rlp_for_each_field (const _Tp &__val, _Fn &&__f)
+{
+  std::apply ([&] (auto... __m) { (__f (__val.*__m), ...); },
+              rlp_schema<_Tp>::fields);
+}
+
+template <typename _Tp> inline constexpr bool __is_rlp_item = false;
+template <typename _Byte>
+inline constexpr bool __is_rlp_item<rlp_item<_Byte> > = true;
+
+template <typename _Tp> struct __rlp_item_view_traits
+{
+  static constexpr bool value = false;
+};
+
+template <typename _Byte> struct __rlp_item_view_traits<rlp_item_view<_Byte> >
+{
+  static constexpr bool value = true;
+  typedef _Byte *pointer;
+};
+
+template <typename _Tp>
+rlp_errc __rlp_decode (const std::uint8_t *__p, const _Rlp_header &__h,
+                       _Tp &__out);
+
+template <typename _Fp>
+rlp_errc
+__rlp_decode_field (const std::uint8_t *&__p, const std::uint8_t *__last,
+                    _Fp &__field)
+{
+  if (__p == __last)
+    return rlp_errc::field_count_mismatch;
+  _Rlp_header __h;
+  rlp_errc __e = __rlp_parse_header (__p, __last - __p, __h);
+  if (__e != rlp_errc ())
+    return __e == rlp_errc::truncated ? rlp_errc::overrun : __e;
+  __e = __rlp_decode (__p, __h, __field);
+  __p += __h._M_offset + __h._M_length;
+  return __e;
+}
+
+template <typename _Tp, std::size_t... _Is>
+rlp_errc
+__rlp_decode_fields (const std::uint8_t *__p, const std::uint8_t *__last,
+                     _Tp &__out, std::index_sequence<_Is...>)
+{
+  rlp_errc __e = rlp_errc ();
+  // Stops at the first field that fails.
+  static_cast<void> ((
+      ((__e = __rlp_decode_field (
+            __p, __last, __out.*std::get<_Is> (rlp_schema<_Tp>::fields)))
+       == rlp_errc ())
+      && ...));
+  if (__e != rlp_errc ())
+    return __e;
+  return __p == __last ? rlp_errc () : rlp_errc::field_count_mismatch;
+}
+
+// Decodes the item at __p, whose header __h has been checked, into __out.
+// Byte views, string views, rlp_items and rlp_item_views are bound to the
+// input rather than copied.
+template <typename _Tp>
+rlp_errc
+__rlp_decode (const std::uint8_t *__p, const _Rlp_header &__h, _Tp &__out)
+{
+  const std::uint8_t *__payload = __p + __h._M_offset;
+  std::size_t __n = __h._M_length;
+  if constexpr (rlp_described<_Tp>)
+    {
+      if (!__h._M_list)
+        return rlp_errc::unexpected_type;
+      return __rlp_decode_fields (
+          __payload, __payload + __n, __out,
+          std::make_index_sequence<__rlp_field_count<_Tp> > ());
+    }
+  else if constexpr (__is_rlp_item<_Tp>)
+    __out = _Tp (reinterpret_cast<typename _Tp::pointer> (__p),
+                 __h._M_offset + __n);
+  else if constexpr (__rlp_item_view_traits<_Tp>::value)
+    {
+      if (!__h._M_list)
+        return rlp_errc::unexpected_type;
+      __out = _Tp (reinterpret_cast<
+                       typename __rlp_item_view_traits<_Tp>::pointer> (
+                       __payload),
+                   __n);
+    }
+  else
+    {
+      if (__h._M_list)
+        return rlp_errc::unexpected_type;
+      if constexpr (std::is_unsigned_v<_Tp>)
+        {
+          if ((__n != 0 && __payload[0] == 0) || __n > sizeof (_Tp))
+            return rlp_errc::invalid_integer;
+          if constexpr (sizeof (_Tp) <= sizeof (std::uint64_t))
+            __out = static_cast<_Tp> (__load_be (__payload, __n));
+          else
+            __bytes_to_unsigned (std::span (__payload, __n), __out);
+        }
+      else if constexpr (__is_boost_multiprecision_number<_Tp>::value)
+        {
+          if ((__n != 0 && __payload[0] == 0)
+              || !__number_from_be (__out, __payload, __n))
+            return rlp_errc::invalid_integer;
+        }
+      else if constexpr (__detail::__is_byte_view<_Tp>)
+        __out = _Tp (reinterpret_cast<typename _Tp::pointer> (__payload), __n);
+      else if constexpr (std::is_trivially_copyable_v<_Tp>
+                         && std::ranges::contiguous_range<_Tp>
+                         && is_underlying_byte_v<range_iter_value_type<_Tp> >)
+        {
+          // Fixed-size byte strings such as fixed_bytes or std::array.
+          if (__n != std::ranges::size (__out))
+            return rlp_errc::length_mismatch;
+          if (__n != 0)
+            std::memcpy (std::ranges::data (__out), __payload, __n);
+        }
+      else if constexpr (std::is_same_v<_Tp, std::string_view>)
+        __out = std::string_view (reinterpret_cast<const char *> (__payload),
+                                  __n);
+      else if constexpr (std::is_same_v<_Tp, std::string>)
+        __out.assign (reinterpret_cast<const char *> (__payload), __n);
+      else
+        static_assert (dependent_false<_Tp>, "field type has no RLP decoding");
+    }
+  return rlp_errc ();
+}
+}
+
+// Decodes the single RLP item in __bytes into the struct __out, following
+// rlp_schema<_Tp>, in one pass and without allocating.  Headers are checked
+// as they are met, so malformed input yields an error rather than a throw.
+template <rlp_described _Tp>
+std::error_code
+rlp_decode (byte_view __bytes, _Tp &__out)
+{
+  const std::uint8_t *__p
+      = reinterpret_cast<const std::uint8_t *> (__bytes.data ());
+  __detail::_Rlp_header __h;
+  rlp_errc __e = __detail::__rlp_parse_header (__p, __bytes.size (), __h);
+  if (__e == rlp_errc ())
+    {
+      if (__h._M_offset + __h._M_length != __bytes.size ())
+        __e = rlp_errc::trailing_bytes;
+      else
+        __e = __detail::__rlp_decode (__p, __h, __out);
+    }
+  if (__e != rlp_errc ())
+    return __e;
+  return std::error_code ();
+}
+
+template <rlp_described _Tp, typename _Byte>
+std::error_code
+rlp_decode (const rlp_item<_Byte> &__item, _Tp &__out)
+{
+  return rlp_decode (byte_view (__item.data (), __item.size ()), __out);
+}
+
+namespace __detail
+{
+
+template <typename _Tp>
+concept __rlp_string = std::is_convertible_v<const _Tp &, std::string_view>;
+
+template <typename _Tp>
+concept __rlp_bytes
+    = !__rlp_string<_Tp> && std::ranges::contiguous_range<const _Tp>
+      && std::ranges::sized_range<const _Tp>
+      && is_underlying_byte_v<std::ranges::range_value_t<const _Tp> >;
+
+template <typename _Tp>
+concept __rlp_list = !rlp_described<_Tp> && !__rlp_string<_Tp>
+                     && !__rlp_bytes<_Tp>
+                     && std::ranges::forward_range<const _Tp>;
+
+template <typename _Tp>
+concept __rlp_encodable = std::is_unsigned_v<_Tp>
+                          || __is_boost_multiprecision_number<_Tp>::value
+                          || __rlp_string<_Tp> || __rlp_bytes<_Tp>
+                          || __rlp_list<_Tp> || rlp_described<_Tp>;
+
+constexpr std::size_t
+__rlp_header_length (std::size_t __n) noexcept
+{
+  return __n < 56 ? 1 : 1 + __unsigned_to_bytes_len (__n);
+}
+
+constexpr std::string_view
+__rlp_string_view (std::string_view __str) noexcept
+{
+  return __str;
+}
+
+constexpr std::string_view
+__rlp_string_view (const char *__str) noexcept
+{
+  if (__str == nullptr)
+    return {};
+  return std::string_view (__str);
+}
+
+// Strings spelled "0x..." hold hex and encode as the bytes the digits
+// denote; any other string encodes as its characters.
+constexpr bool
+__rlp_is_hex (std::string_view __str) noexcept
+{
+  return __str.size () >= 2 && __str[0] == '0' && __str[1] == 'x';
+}
+
+// The value of a one or two digit hex string, or 0xff if it is malformed,
+// which the writer then rejects.
+constexpr std::uint8_t
+__rlp_hex_byte (std::string_view __digits) noexcept
+{
+  std::uint8_t __v = 0;
+  for (char __c : __digits)
+    {
+      std::uint8_t __d = __hex_values[std::uint8_t (__c)];
+      if (__d == 0xff)
+        return 0xff;
+      __v = std::uint8_t (__v << 4 | __d);
+    }
+  return __v;
+}
+
+constexpr std::size_t
+__rlp_hex_length (std::string_view __digits) noexcept
+{
+  std::size_t __n = (__digits.size () + 1) / 2;
+  if (__n == 1 && __rlp_hex_byte (__digits) < 0x80)
+    return 1;
+  return __rlp_header_length (__n) + __n;
+}
+
+template <typename _Tp>
+constexpr std::size_t
+__rlp_number_bytes_len (const _Tp &__val)
+{
+  if constexpr (__has_wide_limbs<_Tp>)
+    {
+      // Backends are kept normalized, so only the words of the top limb
+      // can be zero.
+      std::size_t __words
+          = __val.backend ().size ()
+            * (sizeof (__limb_type<_Tp>) / sizeof (std::uint64_t));
+      while (__words > 1 && __number_word (__val, __words - 1) == 0)
+        --__words;
+      return (__words - 1) * 8
+             + __unsigned_to_bytes_len (__number_word (__val, __words - 1));
+    }
+  else
+    {
+      if (__val == 0)
+        return 0;
+      if constexpr (std::numeric_limits<_Tp>::is_signed)
+        return boost::multiprecision::msb (boost::multiprecision::abs (__val))
+                   / 8
+               + 1;
+      else
+        return boost::multiprecision::msb (__val) / 8 + 1;
+    }
+}
+
+template <typename _Byte>
+constexpr std::size_t
+__rlp_bytes_length (const _Byte *__ptr, std::size_t __n) noexcept
+{
+  if (__n == 1 && __rlp_octet (*__ptr) < 0x80)
+    return 1;
+  return __rlp_header_length (__n) + __n;
+}
+
+template <typename _Tp>
+constexpr std::size_t __rlp_length (const _Tp &__val);
+
+template <typename _Range>
+constexpr std::size_t
+__rlp_list_payload_length (const _Range &__range)
+{
+  std::size_t __n = 0;
+  for (const auto &__elem : __range)
+    __n += __rlp_length (__elem);
+  return __n;
+}
+
+template <typename _Tp>
+constexpr std::size_t
+__rlp_fields_payload_length (const _Tp &__val)
+{
+  std::size_t __n = 0;
+  __rlp_for_each_field (__val, [&__n] (const auto &__field) {
+    __n += __rlp_length (__field);
+  });
+  return __n;
+}
+
+template <typename _Tp>
+constexpr std::size_t
+__rlp_length (const _Tp &__val)
+{
+  static_assert (__rlp_encodable<_Tp>, "type has no RLP encoding");
+  if constexpr (std::is_unsigned_v<_Tp>)
+    return __val < 0x80 ? 1 : 1 + __unsigned_to_bytes_len (__val);
+  else if constexpr (__is_boost_multiprecision_number<_Tp>::value)
+    {
+      std::size_t __n = __rlp_number_bytes_len (__val);
+      return __n == 1 && __val < 0x80 ? 1 : __rlp_header_length (__n) + __n;
+    }
+  else if constexpr (__rlp_string<_Tp>)
+    {
+      std::string_view __str = __rlp_string_view (__val);
+      if (__rlp_is_hex (__str))
+        return __rlp_hex_length (__str.substr (2));
+      return __rlp_bytes_length (__str.data (), __str.size ());
+    }
+  else if constexpr (__rlp_bytes<_Tp>)
+    return __rlp_bytes_length (std::ranges::data (__val),
+                               std::ranges::size (__val));
+  else if constexpr (rlp_described<_Tp>)
+    {
+      std::size_t __n = __rlp_fields_payload_length (__val);
+      return __rlp_header_length (__n) + __n;
+    }
+  else
+    {
+      std::size_t __n = __rlp_list_payload_length (__val);
+      return __rlp_header_length (__n) + __n;
+    }
+}
+
+// Payload lengths of the lists and described structs nested in a value,
+// in the order _Rlp_writer reaches them, recorded by __rlp_measure so
+// that encoding sizes every node once instead of once per enclosing
+// list.  The first few lengths live inline, so flat values never
+// allocate; deeper ones spill to storage from _Alloc, which encoders
+// rebind from their own allocator.
+template <typename _Alloc = std::allocator<std::size_t> > class _Rlp_sizes
+{
+  static constexpr std::size_t _S_local = 8;
+
+public:
+  explicit _Rlp_sizes (const _Alloc &__alloc = _Alloc ()) noexcept
+      : _M_size (0), _M_heap (__alloc)
+  {
+  }
+
+  _Rlp_sizes (const _Rlp_sizes &) = delete;
+  _Rlp_sizes &operator= (const _Rlp_sizes &) = delete;
+
+  // Appends a slot for a length measured later and returns its index.
+  std::size_t
+  _M_push ()
+  {
+    if (_M_size == _S_local && _M_heap.empty ())
+      _M_heap.assign (_M_local, _M_local + _S_local);
+    if (_M_heap.empty ())
+      _M_local[_M_size] = 0;
+    else
+      _M_heap.push_back (0);
+    return _M_size++;
+  }
+
+  std::size_t &
+  operator[] (std::size_t __i) noexcept
+  {
+    return _M_heap.empty () ? _M_local[__i] : _M_heap[__i];
+  }
+
+  const std::size_t *
+  _M_data () const noexcept
+  {
+    return _M_heap.empty () ? _M_local : _M_heap.data ();
+  }
+
+private:
+  std::size_t _M_local[_S_local];
+  std::size_t _M_size;
+  std::vector<std::size_t, _Alloc> _M_heap;
+};
+
+// _Rlp_sizes drawing from the same resource as a buffer allocated by
+// _Alloc.
+template <typename _Alloc>
+using _Rlp_sizes_for = _Rlp_sizes<
+    typename std::allocator_traits<_Alloc>::template rebind_alloc<
+        std::size_t> >;
+
+// The encoded length of __val, as __rlp_length, also recording in
+// __sizes the payload length of every list and described struct in it.
+template <typename _Tp, typename _Alloc>
+std::size_t
+__rlp_measure (const _Tp &__val, _Rlp_sizes<_Alloc> &__sizes)
+{
+  if constexpr (__rlp_list<_Tp>)
+    {
+      std::size_t __slot = __sizes._M_push ();
+      std::size_t __n = 0;
+      for (const auto &__elem : __val)
+        __n += __rlp_measure (__elem, __sizes);
+      __sizes[__slot] = __n;
+      return __rlp_header_length (__n) + __n;
+    }
+  else if constexpr (rlp_described<_Tp>)
+    {
+      std::size_t __slot = __sizes._M_push ();
+      std::size_t __n = 0;
+      __rlp_for_each_field (__val, [&] (const auto &__field) {
+        __n += __rlp_measure (__field, __sizes);
+      });
+      __sizes[__slot] = __n;
+      return __rlp_header_length (__n) + __n;
+    }
+  else
+    return __rlp_length (__val);
+}
+
+inline constexpr std::size_t __rlp_unbounded = std::size_t (-1);
+
+template <typename _Tp>
+inline constexpr std::size_t __rlp_static_extent = std::dynamic_extent;
+
+template <typename _Tp, std::size_t _Nm>
+inline constexpr std::size_t __rlp_static_extent<std::array<_Tp, _Nm> > = _Nm;
+
+// std::span, fixed_bytes and anything else publishing a static extent.
+template <typename _Tp>
+requires requires { std::integral_constant<std::size_t, _Tp::extent>{}; }
+inline constexpr std::size_t __rlp_static_extent<_Tp> = _Tp::extent;
+
+template <typename _Tp> constexpr std::size_t __rlp_max_length ();
+
+template <typename _Tp, std::size_t... _Is>
+constexpr std::size_t
+__rlp_max_fields_length (std::index_sequence<_Is...>)
+{
+  constexpr std::size_t __lens[] = { __rlp_max_length<std::remove_cvref_t<
+      decltype (std::declval<const _Tp &> ()
+                .*std::get<_Is> (rlp_schema<_Tp>::fields))> > ()... };
+  std::size_t __n = 0;
+  for (std::size_t __len : __lens)
+    {
+      if (__len == __rlp_unbounded)
+        return __rlp_unbounded;
+      __n += __len;
+    }
+  return __rlp_header_length (__n) + __n;
+}
+
+// The largest encoding any value of _Tp can have, or __rlp_unbounded.
+template <typename _Tp>
+constexpr std::size_t
+__rlp_max_length ()
+{
+  if constexpr (rlp_described<_Tp>)
+    {
+      if constexpr (__rlp_field_count<_Tp> == 0)
+        return 1;
+      else
+        return __rlp_max_fields_length<_Tp> (
+            std::make_index_sequence<__rlp_field_count<_Tp> > ());
+    }
+  else if constexpr (std::is_unsigned_v<_Tp>)
+    return 1 + sizeof (_Tp);
+  else if constexpr (__is_boost_multiprecision_number<_Tp>::value)
+    {
+      if constexpr (std::numeric_limits<_Tp>::is_bounded)
+        {
+          constexpr std::size_t __n
+              = (std::numeric_limits<_Tp>::digits + 7) / 8;
+          return __rlp_header_length (__n) + __n;
+        }
+      else
+        return __rlp_unbounded;
+    }
+  else if constexpr (__rlp_static_extent<_Tp> == std::dynamic_extent)
+    return __rlp_unbounded;
+  else if constexpr (__rlp_bytes<_Tp>)
+    return __rlp_header_length (__rlp_static_extent<_Tp>)
+           + __rlp_static_extent<_Tp>;
+  else
+    {
+      constexpr std::size_t __elem
+          = __rlp_max_length<std::ranges::range_value_t<_Tp> > ();
+      if constexpr (__elem == __rlp_unbounded)
+        return __rlp_unbounded;
+      else
+        {
+          constexpr std::size_t __n = __elem * __rlp_static_extent<_Tp>;
+          return __rlp_header_length (__n) + __n;
+        }
+    }
+}
+
+// Serializes into memory whose size was obtained from rlp_length, so no
+// bounds are checked and nothing is buffered: every byte is written once.
+template <typename _Byte> struct _Rlp_writer
+{
+  _Byte *_M_cur;
+  // The list lengths recorded by __rlp_measure for the value being
+  // written, consumed in order.
+  const std::size_t *_M_sizes = nullptr;
+
+  std::size_t
+  _M_next_size () noexcept
   {
-    _M_iter = _Base::begin ();
-    _M_next ();
+    assert (_M_sizes != nullptr);
+    return *_M_sizes++;
   }
 
-  rlp_item_iterator (const _Rlp_item_type &__item)
-      : _Base (__item.begin (), __item.end ()), _M_value ()
+  constexpr void
+  _M_put (std::uint8_t __c) noexcept
   {
-    _M_iter = _Base::begin ();
-    _M_next ();
+    *_M_cur++ = static_cast<_Byte> (__c);
   }
 
-  rlp_item_iterator &operator= (const rlp_item_iterator &) = default;
-  ~rlp_item_iterator () = default;
-
-  const value_type &
-  operator* () const
+  void
+  _M_put (const void *__ptr, std::size_t __n) noexcept
   {
-    return _M_value;
+    if (__n != 0)
+      std::memcpy (_M_cur, __ptr, __n);
+    _M_cur += __n;
   }
 
-  const value_type *
-  operator->() const
+  template <typename _Tp>
+  constexpr void
+  _M_put_unsigned (_Tp __val, std::size_t __n) noexcept
   {
-    return std::addressof (_M_value);
+    if constexpr (sizeof (_Tp) <= sizeof (std::uint64_t))
+      {
+        if (__n != 0)
+          __store_be (_M_cur, __val, __n);
+      }
+    else
+      for (std::size_t __i = __n; __i > 0; --__i, __val >>= 8)
+        _M_cur[__i - 1] = static_cast<_Byte> (__val & 0xff);
+    _M_cur += __n;
   }
 
-  rlp_item_iterator &
-  operator++ ()
+  // Writes the __n magnitude bytes of __val a 64-bit word at a time, so a
+  // uint256 is four byte swaps.
+  template <typename _Tp>
+  void
+  _M_put_number (const _Tp &__val, std::size_t __n) noexcept
   {
-    _M_next ();
-    return *this;
+    if constexpr (__has_wide_limbs<_Tp>)
+      {
+        std::size_t __words = (__n + 7) / 8;
+        std::size_t __head = __n - 8 * (__words - 1);
+        __store_be (_M_cur, __number_word (__val, __words - 1), __head);
+        _M_cur += __head;
+        for (std::size_t __i = __words - 1; __i > 0; --__i, _M_cur += 8)
+          __store_be (_M_cur, __number_word (__val, __i - 1), 8);
+      }
+    else
+      _M_cur = boost::multiprecision::export_bits (__val, _M_cur, 8);
   }
 
-  rlp_item_iterator
-  operator++ (int)
+  constexpr void
+  _M_put_header (std::size_t __n, std::uint8_t __short,
+                 std::uint8_t __long) noexcept
   {
-    rlp_item_iterator __tmp = *this;
-    ++*this;
-    return __tmp;
+    if (__n < 56)
+      _M_put (static_cast<std::uint8_t> (__short + __n));
+    else
+      {
+        std::size_t __len = __unsigned_to_bytes_len (__n);
+        _M_put (static_cast<std::uint8_t> (__long + __len));
+        _M_put_unsigned (__n, __len);
+      }
   }
 
-private:
   void
-  _M_next ()
+  _M_put_bytes (const void *__ptr, std::size_t __n) noexcept
   {
-    typename _Base::iterator __end = _Base::end ();
-    if (_M_iter != __end)
-      {
-        typedef typename _Base::size_type _Size_type;
-        // offset, length
-        std::pair<_Size_type, _Size_type> __pos
-            = _Rlp_item_type (_M_iter, __end)._M_position ();
-        std::size_t __offlen = __pos.first + __pos.second;
-        _M_value = _Rlp_item_type (_M_iter, _M_iter + __offlen);
-        _M_iter += __offlen;
-      }
+    if (__n == 1 && *static_cast<const std::uint8_t *> (__ptr) < 0x80)
+      _M_put (*static_cast<const std::uint8_t *> (__ptr));
     else
       {
-        _M_done = true;
+        _M_put_header (__n, 0x80, 0xb7);
+        _M_put (__ptr, __n);
       }
   }
 
-public:
-  bool
-  _M_equal (const rlp_item_iterator &__x) const
+  // Decodes __digits straight into the output; throws invalid_argument if
+  // they are not hex, leaving the output partly written.
+  void
+  _M_put_hex (std::string_view __digits)
   {
-    if (_M_done && __x._M_done)
-      return true;
-    return _Base::data () == __x.data () && _Base::size () == __x.size ()
-           && _M_iter == __x._M_iter && _M_value == __x._M_value;
+    std::size_t __n = (__digits.size () + 1) / 2;
+    if (__n == 1 && __rlp_hex_byte (__digits) < 0x80)
+      return _M_put (__rlp_hex_byte (__digits));
+    _M_put_header (__n, 0x80, 0xb7);
+    if (!hex_decode (__digits, mutable_byte_view (_M_cur, __n)))
+      throw std::invalid_argument ("rlp: malformed hex string");
+    _M_cur += __n;
   }
 
-  friend bool
-  operator== (const rlp_item_iterator &__x, const rlp_item_iterator &__y)
+  template <typename _Range>
+  void
+  _M_put_list (const _Range &__range, std::size_t __payload_len)
   {
-    return __x._M_equal (__y);
+    _M_put_header (__payload_len, 0xc0, 0xf7);
+    for (const auto &__elem : __range)
+      _M_write (__elem);
   }
 
-  friend bool
-  operator!= (const rlp_item_iterator &__x, const rlp_item_iterator &__y)
+  template <typename _Tp>
+  void
+  _M_write (const _Tp &__val)
   {
-    return !__x._M_equal (__y);
+    if constexpr (std::is_unsigned_v<_Tp>)
+      {
+        if (__val != 0 && __val < 0x80)
+          _M_put (static_cast<std::uint8_t> (__val));
+        else
+          {
+            std::size_t __n = __unsigned_to_bytes_len (__val);
+            _M_put (static_cast<std::uint8_t> (0x80 + __n));
+            _M_put_unsigned (__val, __n);
+          }
+      }
+    else if constexpr (__is_boost_multiprecision_number<_Tp>::value)
+      {
+        std::size_t __n = __rlp_number_bytes_len (__val);
+        if (__n == 1 && __val < 0x80)
+          _M_put (static_cast<std::uint8_t> (__val));
+        else
+          {
+            _M_put_header (__n, 0x80, 0xb7);
+            if (__n != 0)
+              _M_put_number (__val, __n);
+          }
+      }
+    else if constexpr (__rlp_string<_Tp>)
+      {
+        std::string_view __str = __rlp_string_view (__val);
+        if (__rlp_is_hex (__str))
+          _M_put_hex (__str.substr (2));
+        else
+          _M_put_bytes (__str.data (), __str.size ());
+      }
+    else if constexpr (__rlp_bytes<_Tp>)
+      _M_put_bytes (std::ranges::data (__val), std::ranges::size (__val));
+    else if constexpr (rlp_described<_Tp>)
+      {
+        _M_put_header (_M_next_size (), 0xc0, 0xf7);
+        __rlp_for_each_field (
+            __val, [this] (const auto &__field) { _M_write (__field); });
+      }
+    else
+      _M_put_list (__val, _M_next_size ());
   }
-
-private:
-  _Rlp_item_type _M_value;
-  typename _Base::iterator _M_iter;
-  bool _M_done;
 };
+}
+
+// The exact number of bytes __val occupies once RLP encoded.  Unsigned
+// integers, boost numbers, strings and byte ranges encode as strings; any
+// other forward range, or a struct described by rlp_schema, as a list.
+template <typename _Tp>
+requires __detail::__rlp_encodable<_Tp>
+constexpr std::size_t
+rlp_length (const _Tp &__val)
+{
+  return __detail::__rlp_length (__val);
+}
+
+// Types whose encoding has a size bound known at compile time: fixed-width
+// integers, fixed-extent byte arrays and spans, arrays of bounded types and
+// described structs whose fields are all bounded.
+template <typename _Tp>
+concept rlp_bounded
+    = __detail::__rlp_max_length<_Tp> () != __detail::__rlp_unbounded;
+
+// The largest rlp_length of any _Tp, e.g. to size a stack buffer for
+// rlp_encode_into.
+template <rlp_bounded _Tp>
+inline constexpr std::size_t rlp_max_length_v
+    = __detail::__rlp_max_length<_Tp> ();
+
+// Encoded length of __range as a list, whatever its element type.
+template <std::ranges::forward_range _Range>
+constexpr std::size_t
+rlp_list_length (const _Range &__range)
+{
+  std::size_t __n = __detail::__rlp_list_payload_length (__range);
+  return __detail::__rlp_header_length (__n) + __n;
+}
+
+// Encodes __val straight into __out, which must hold at least
+// rlp_length (__val) bytes, and returns the number of bytes written.
+template <std::ranges::contiguous_range _Out, typename _Tp>
+requires std::ranges::sized_range<_Out>
+         && is_underlying_byte_v<range_iter_value_type<_Out> >
+         && (!std::is_const_v<range_iter_value_type<_Out> >)
+         && __detail::__rlp_encodable<_Tp>
+std::size_t
+rlp_encode_into (_Out &&__out, const _Tp &__val)
+{
+  __detail::_Rlp_sizes<> __sizes;
+  std::size_t __n = __detail::__rlp_measure (__val, __sizes);
+  if (std::ranges::size (__out) < __n)
+    throw std::length_error ("rlp_encode_into");
+  __detail::_Rlp_writer<range_iter_value_type<_Out> > __writer{
+    std::ranges::data (__out), __sizes._M_data ()
+  };
+  __writer._M_write (__val);
+  return __n;
+}
 
 template <typename _Byte, typename _Alloc> class _Rlp_buffer_base
 {
@@ -536,6 +1851,20 @@ public:
     return _M_get_buffer ().clear ();
   }
 
+  constexpr void
+  reserve (size_type __n)
+  {
+    _M_get_buffer ().reserve (__n);
+  }
+
+  // Hands the encoded bytes over, e.g. to a chunked_buffer, and leaves the
+  // buffer empty.
+  constexpr std::vector<_Byte, _Alloc>
+  release () noexcept
+  {
+    return std::exchange (_M_get_buffer (), _Buffer_type (get_allocator ()));
+  }
+
 protected:
   class _Rlp_encoder_base
   {
@@ -557,36 +1886,29 @@ protected:
       _M_buffer.insert (_M_buffer.end (), __bytes.begin (), __bytes.end ());
     }
 
-    constexpr void
-    _M_do_encode (value_type __c)
+    // Grows the buffer by exactly __n bytes and returns a writer positioned
+    // at the start of the new tail.
+    constexpr __detail::_Rlp_writer<_Byte>
+    _M_extend (std::size_t __n)
     {
-      _M_buffer.push_back (__c);
+      std::size_t __size = _M_buffer.size ();
+      _M_buffer.resize (__size + __n);
+      return __detail::_Rlp_writer<_Byte>{ _M_buffer.data () + __size };
     }
 
+    // Drops the last __n bytes.
     constexpr void
-    _M_do_encode (const _Buffer_type &__bytes, _Byte __prefix1,
-                  _Byte __prefix2)
+    _M_shrink (std::size_t __n) noexcept
     {
-      std::size_t __n = __bytes.size ();
-      if (__n < 56)
-        {
-          _M_buffer.push_back (static_cast<_Byte> (__prefix1 + __n));
-          _M_buffer.insert (_M_buffer.end (), __bytes.begin (),
-                            __bytes.end ());
-        }
-      else
-        {
-          _Buffer_type __nstrlen;
-          __detail::__unsigned_to_bytes (__n, __nstrlen);
-          std::size_t __len = __nstrlen.size ();
-          if (__len + __prefix2 > 0xff)
-            throw std::runtime_error ("Too large RLP");
-          _M_buffer.push_back (static_cast<_Byte> (__len + __prefix2));
-          _M_buffer.insert (_M_buffer.end (), __nstrlen.begin (),
-                            __nstrlen.end ());
-          _M_buffer.insert (_M_buffer.end (), __bytes.begin (),
-                            __bytes.end ());
-        }
+      _M_buffer.resize (_M_buffer.size () - __n);
+    }
+
+    // Opens a gap of __n bytes at offset __pos and returns a writer there.
+    constexpr __detail::_Rlp_writer<_Byte>
+    _M_insert (std::size_t __pos, std::size_t __n)
+    {
+      _M_buffer.insert (_M_buffer.begin () + __pos, __n, _Byte ());
+      return __detail::_Rlp_writer<_Byte>{ _M_buffer.data () + __pos };
     }
 
   private:
@@ -597,23 +1919,70 @@ protected:
   class _Rlp_encoder : public _Rlp_encoder_base
   {
   public:
-    using _Rlp_encoder_base::_M_do_encode;
     using _Rlp_encoder_base::_Rlp_encoder_base;
 
+    // Both encoders give the strong guarantee: a malformed hex string
+    // leaves the buffer as it was.
+    template <typename _Tp>
+    constexpr void
+    _M_do_rlp_data_encode (const _Tp &__val)
+    {
+      __detail::_Rlp_sizes_for<_Alloc> __sizes (
+          this->_M_buffer.get_allocator ());
+      std::size_t __n = __detail::__rlp_measure (__val, __sizes);
+      __detail::_Rlp_writer<_Byte> __writer = this->_M_extend (__n);
+      __writer._M_sizes = __sizes._M_data ();
+      try
+        {
+          __writer._M_write (__val);
+        }
+      catch (...)
+        {
+          this->_M_shrink (__n);
+          throw;
+        }
+    }
+
+    template <typename _Range>
+    constexpr void
+    _M_do_rlp_list_encode (const _Range &__range)
+    {
+      __detail::_Rlp_sizes_for<_Alloc> __sizes (
+          this->_M_buffer.get_allocator ());
+      std::size_t __n = 0;
+      for (const auto &__elem : __range)
+        __n += __detail::__rlp_measure (__elem, __sizes);
+      std::size_t __len = __detail::__rlp_header_length (__n) + __n;
+      __detail::_Rlp_writer<_Byte> __writer = this->_M_extend (__len);
+      __writer._M_sizes = __sizes._M_data ();
+      try
+        {
+          __writer._M_put_list (__range, __n);
+        }
+      catch (...)
+        {
+          this->_M_shrink (__len);
+          throw;
+        }
+    }
+
     constexpr void
-    _M_do_rlp_data_encode (const _Buffer_type &__bytes)
+    _M_do_rlp_raw_list_encode (const _Buffer_type &__bytes)
     {
       std::size_t __n = __bytes.size ();
-      if (__n == 1 && __bytes.front () < 0x80)
-        _M_do_encode (__bytes.front ());
-      else
-        _M_do_encode (__bytes, 0x80, 0xb7);
+      __detail::_Rlp_writer<_Byte> __writer
+          = this->_M_extend (__detail::__rlp_header_length (__n) + __n);
+      __writer._M_put_header (__n, 0xc0, 0xf7);
+      __writer._M_put (__bytes.data (), __n);
     }
 
+    // Turns the __n bytes appended at offset __start into one list by
+    // inserting its header in front of them.
     constexpr void
-    _M_do_rlp_list_encode (const _Buffer_type &__bytes)
+    _M_do_rlp_list_close (std::size_t __start, std::size_t __n)
     {
-      _M_do_encode (__bytes, 0xc0, 0xf7);
+      this->_M_insert (__start, __detail::__rlp_header_length (__n))
+          ._M_put_header (__n, 0xc0, 0xf7);
     }
   };
 
@@ -648,18 +2017,22 @@ class rlp_buffer : public _Rlp_buffer_base<_Byte, _Alloc>
   using _Base::_M_get_rlp_encoder;
 
 public:
+  using _Base::_Base;
+
+  constexpr rlp_buffer () = default;
+
   constexpr rlp_buffer &
-  put (bigint __val)
+  put (const bigint &__val)
   {
-    _Buffer_type __buffer;
-    if (!__val)
-      _M_get_rlp_encoder ()._M_do_rlp_data_encode (__buffer);
-    else
-      {
-        boost::multiprecision::export_bits (__val,
-                                            std::back_inserter (__buffer), 8);
-        _M_get_rlp_encoder ()._M_do_rlp_data_encode (__buffer);
-      }
+    _M_get_rlp_encoder ()._M_do_rlp_data_encode (__val);
+    return *this;
+  }
+
+  template <typename _Tp>
+  requires __is_boost_multiprecision_number<_Tp>::value constexpr rlp_buffer &
+  put (const _Tp &__val)
+  {
+    _M_get_rlp_encoder ()._M_do_rlp_data_encode (__val);
     return *this;
   }
 
@@ -667,9 +2040,7 @@ public:
   requires std::is_unsigned_v<_Tp> constexpr rlp_buffer &
   put (_Tp __val)
   {
-    _Buffer_type __buffer;
-    __detail::__unsigned_to_bytes (__val, __buffer);
-    _M_get_rlp_encoder ()._M_do_rlp_data_encode (__buffer);
+    _M_get_rlp_encoder ()._M_do_rlp_data_encode (__val);
     return *this;
   }
 
@@ -683,44 +2054,64 @@ public:
   constexpr rlp_buffer &
   put (const std::string &__str)
   {
-    std::size_t __prefix_offset = 0;
-    if (_M_has_hex_prefixed (__str))
-      __prefix_offset = 2;
-    _Buffer_type __buffer (__str.begin () + __prefix_offset, __str.end ());
-    _M_get_rlp_encoder ()._M_do_rlp_data_encode (__buffer);
+    _M_get_rlp_encoder ()._M_do_rlp_data_encode (__str);
     return *this;
   }
 
   constexpr rlp_buffer &
   put (const char *__str)
   {
-    if (__str == nullptr)
-      return put (_Buffer_type ());
-    return put (std::string (__str));
+    _M_get_rlp_encoder ()._M_do_rlp_data_encode (__str);
+    return *this;
+  }
+
+  // Any other encodable value: byte ranges as strings, other ranges as
+  // (possibly nested) lists, described structs as the list of their fields.
+  template <typename _Tp>
+  requires __detail::__rlp_bytes<_Tp> || __detail::__rlp_list<_Tp>
+           || rlp_described<_Tp>
+  constexpr rlp_buffer &
+  put (const _Tp &__val)
+  {
+    _M_get_rlp_encoder ()._M_do_rlp_data_encode (__val);
+    return *this;
   }
 
+  // Forward ranges are sized first and then written in place, so nested
+  // lists never pass through intermediate buffers.  Single-pass ranges are
+  // written in place too and their header is inserted once the payload
+  // length is known.
   template <typename _Range>
   requires std::ranges::input_range<_Range> constexpr rlp_buffer &
   putl (_Range &&__range)
   {
-    using __iterator = std::ranges::iterator_t<_Range>;
-    rlp_buffer __rlp_buffer;
-    __iterator __begin = std::ranges::begin (__range),
-               __end = std::ranges::end (__range);
-    for (; __begin != __end; ++__begin)
+    if constexpr (std::ranges::forward_range<
+                      const std::remove_reference_t<_Range> >)
+      _M_get_rlp_encoder ()._M_do_rlp_list_encode (__range);
+    else
       {
-        __rlp_buffer.put (*__begin);
+        // Elements already written are dropped if a later one throws.
+        std::size_t __start = this->size ();
+        try
+          {
+            for (auto &&__elem : __range)
+              put (__elem);
+            _M_get_rlp_encoder ()._M_do_rlp_list_close (
+                __start, this->size () - __start);
+          }
+        catch (...)
+          {
+            _M_get_rlp_encoder ()._M_shrink (this->size () - __start);
+            throw;
+          }
       }
-
-    _M_get_rlp_encoder ()._M_do_rlp_list_encode (
-        __rlp_buffer._M_get_buffer ());
     return *this;
   }
 
   constexpr rlp_buffer &
   putl (const _Buffer_type &__rawlist)
   {
-    _M_get_rlp_encoder ()._M_do_rlp_list_encode (__rawlist);
+    _M_get_rlp_encoder ()._M_do_rlp_raw_list_encode (__rawlist);
     return *this;
   }
 
@@ -738,14 +2129,203 @@ public:
     return *this;
   }
 
+  // Appends already encoded bytes, e.g. the output of rlp_reverse_writer.
+  template <typename _Tp>
+  requires __detail::__rlp_bytes<_Tp> constexpr rlp_buffer &
+  concat (const _Tp &__raw)
+  {
+    std::size_t __n = std::ranges::size (__raw);
+    _M_get_rlp_encoder ()._M_extend (__n)._M_put (std::ranges::data (__raw),
+                                                  __n);
+    return *this;
+  }
+};
+
+// Serializes back to front into a single region that fills from its end.
+// A list is closed after its children have been written, when the length of
+// its payload is already known, so the header is simply prepended and the
+// payload never moves.  Children are therefore emitted last to first:
+//
+//   rlp_reverse_writer<> __w;
+//   auto __m = __w.mark ();
+//   __w.put (__c).put (__b).put (__a);
+//   __w.list (__m);                       // [a, b, c]
+//
+// When the region is exhausted it is reallocated with the written bytes
+// moved to the end of the new region; this is the only copy ever made.
+template <typename _Byte = byte, typename _Alloc = std::allocator<_Byte> >
+class rlp_reverse_writer
+{
+  typedef std::vector<_Byte, _Alloc> _Buffer_type;
+
+public:
+  typedef _Byte value_type;
+  typedef std::size_t size_type;
+  typedef const _Byte *const_iterator;
+  typedef const _Byte *iterator;
+  typedef _Alloc allocator_type;
+
+  explicit rlp_reverse_writer (size_type __capacity = 256,
+                               const _Alloc &__alloc = _Alloc ())
+      : _M_buffer (__capacity, __alloc), _M_head (__capacity)
+  {
+  }
+
+  // An opaque position; pass it to list () to wrap everything written since.
+  size_type
+  mark () const noexcept
+  {
+    return size ();
+  }
+
+  template <typename _Tp>
+  requires __detail::__rlp_encodable<_Tp> rlp_reverse_writer &
+  put (const _Tp &__val)
+  {
+    __detail::_Rlp_sizes_for<_Alloc> __sizes (_M_buffer.get_allocator ());
+    size_type __n = __detail::__rlp_measure (__val, __sizes);
+    __detail::_Rlp_writer<_Byte> __writer = _M_prepend (__n);
+    __writer._M_sizes = __sizes._M_data ();
+    try
+      {
+        __writer._M_write (__val);
+      }
+    catch (...)
+      {
+        _M_head += __n;
+        throw;
+      }
+    return *this;
+  }
+
+  // Closes the list whose children were put since __mark was taken.
+  // Throws std::out_of_range if __mark is past the bytes written.
+  rlp_reverse_writer &
+  list (size_type __mark)
+  {
+    if (__mark > size ())
+      throw std::out_of_range ("rlp_reverse_writer::list");
+    size_type __n = size () - __mark;
+    _M_prepend (__detail::__rlp_header_length (__n))
+        ._M_put_header (__n, 0xc0, 0xf7);
+    return *this;
+  }
+
+  // Encodes __range as a list, visiting its elements from the back.
+  template <std::ranges::bidirectional_range _Range>
+  rlp_reverse_writer &
+  putl (const _Range &__range)
+  {
+    size_type __mark = mark ();
+    try
+      {
+        for (auto __it = std::ranges::end (__range);
+             __it != std::ranges::begin (__range);)
+          put (*--__it);
+      }
+    catch (...)
+      {
+        _M_head = _M_buffer.size () - __mark;
+        throw;
+      }
+    return list (__mark);
+  }
+
+  // Prepends bytes that are already RLP encoded.
+  template <typename _Tp>
+  requires __detail::__rlp_bytes<_Tp> rlp_reverse_writer &
+  concat (const _Tp &__raw)
+  {
+    std::size_t __n = std::ranges::size (__raw);
+    _M_prepend (__n)._M_put (std::ranges::data (__raw), __n);
+    return *this;
+  }
+
+  const _Byte *
+  data () const noexcept
+  {
+    return _M_buffer.data () + _M_head;
+  }
+
+  size_type
+  size () const noexcept
+  {
+    return _M_buffer.size () - _M_head;
+  }
+
+  bool
+  empty () const noexcept
+  {
+    return size () == 0;
+  }
+
+  size_type
+  capacity () const noexcept
+  {
+    return _M_buffer.size ();
+  }
+
+  const_iterator
+  begin () const noexcept
+  {
+    return data ();
+  }
+
+  const_iterator
+  end () const noexcept
+  {
+    return _M_buffer.data () + _M_buffer.size ();
+  }
+
+  void
+  clear () noexcept
+  {
+    _M_head = _M_buffer.size ();
+  }
+
+  allocator_type
+  get_allocator () const noexcept
+  {
+    return _M_buffer.get_allocator ();
+  }
+
 private:
-  constexpr bool
-  _M_has_hex_prefixed (const std::string &__str) const noexcept
+  __detail::_Rlp_writer<_Byte>
+  _M_prepend (size_type __n)
   {
-    return __str.length () >= 2 && __str[0] == '0' && __str[1] == 'x';
+    if (__n > _M_head)
+      {
+        size_type __size = size ();
+        size_type __capacity = std::max (_M_buffer.size () * 2, __size + __n);
+        _Buffer_type __buffer (__capacity, _M_buffer.get_allocator ());
+        std::copy (begin (), end (), __buffer.end () - __size);
+        _M_buffer.swap (__buffer);
+        _M_head = __capacity - __size;
+      }
+    _M_head -= __n;
+    return __detail::_Rlp_writer<_Byte>{ _M_buffer.data () + _M_head };
   }
+
+  _Buffer_type _M_buffer;
+  size_type _M_head;
 };
 
+namespace pmr
+{
+template <typename _Byte = byte>
+using rlp_buffer
+    = basic::rlp_buffer<_Byte, std::pmr::polymorphic_allocator<_Byte> >;
+
+template <typename _Byte = byte>
+using rlp_reverse_writer
+    = basic::rlp_reverse_writer<_Byte,
+                                std::pmr::polymorphic_allocator<_Byte> >;
+}
+
 } // namespace basic
 
+template <typename _Byte>
+inline constexpr bool
+    std::ranges::enable_borrowed_range<basic::rlp_item_view<_Byte> > = true;
+
 #endif //__LIBBASIC_RLP_H__
\ No newline at end of file
@@ -0,0 +1,105 @@
+#ifndef __LIBBASIC_RLP_ERROR_H__
+#define __LIBBASIC_RLP_ERROR_H__
+
+#include <string>
+#include <system_error>
+
+namespace basic
+{
+
+enum class rlp_errc
+{
+  // The input ends inside an item header or payload.
+  truncated = 1,
+  // A child item extends past the end of its enclosing list.
+  overrun,
+  // A length is stored in long form although it fits in the prefix, or
+  // with leading zero bytes.
+  non_canonical_size,
+  // A single byte below 0x80 is wrapped in a one-byte string header.
+  non_canonical_single_byte,
+  // Lists are nested deeper than the caller allows.
+  depth_exceeded,
+  // An item has a different kind (string or list) than was asked for.
+  unexpected_type,
+  // An integer payload has leading zeros or is wider than its target.
+  invalid_integer,
+  // A list has more or fewer items than the schema it is decoded into.
+  field_count_mismatch,
+  // A string is longer or shorter than the fixed-size field it is
+  // decoded into.
+  length_mismatch,
+  // Bytes remain after the item that was decoded.
+  trailing_bytes,
+  // An item is larger than the caller allows.
+  item_too_large,
+  // The input holds more items than can be indexed.
+  too_many_items,
+};
+
+namespace __detail
+{
+class _Rlp_error_category final : public std::error_category
+{
+public:
+  const char *
+  name () const noexcept override
+  {
+    return "rlp";
+  }
+
+  std::string
+  message (int __ev) const override
+  {
+    switch (static_cast<rlp_errc> (__ev))
+      {
+      case rlp_errc::truncated:
+        return "truncated RLP input";
+      case rlp_errc::overrun:
+        return "RLP item overruns its enclosing list";
+      case rlp_errc::non_canonical_size:
+        return "non-canonical RLP length";
+      case rlp_errc::non_canonical_single_byte:
+        return "non-canonical RLP single byte";
+      case rlp_errc::depth_exceeded:
+        return "RLP nesting too deep";
+      case rlp_errc::unexpected_type:
+        return "unexpected RLP item type";
+      case rlp_errc::invalid_integer:
+        return "invalid RLP integer";
+      case rlp_errc::field_count_mismatch:
+        return "RLP list does not match its schema";
+      case rlp_errc::length_mismatch:
+        return "RLP string does not match its field length";
+      case rlp_errc::trailing_bytes:
+        return "trailing bytes after RLP item";
+      case rlp_errc::item_too_large:
+        return "RLP item too large";
+      case rlp_errc::too_many_items:
+        return "too many RLP items";
+      }
+    return "unknown RLP error";
+  }
+};
+}
+
+inline const std::error_category &
+rlp_category () noexcept
+{
+  static const __detail::_Rlp_error_category __category;
+  return __category;
+}
+
+inline std::error_code
+make_error_code (rlp_errc __e) noexcept
+{
+  return std::error_code (static_cast<int> (__e), rlp_category ());
+}
+
+} // namespace basic
+
+template <> struct std::is_error_code_enum<basic::rlp_errc> : std::true_type
+{
+};
+
+#endif //__LIBBASIC_RLP_ERROR_H__
@@ -0,0 +1,139 @@
+#ifndef __LIBBASIC_RLP_FRAME_H__
+#define __LIBBASIC_RLP_FRAME_H__
+
+#include "rlp.h"
+#include <cstdint>
+#include <limits>
+
+namespace basic
+{
+
+// The outcome of rlp_frame_decoder::next.  Either size is the length of
+// the complete item at the front of the input, or needed is how many more
+// bytes must arrive before next can tell more, or ec is set.
+struct rlp_frame
+{
+  std::size_t size;
+  std::size_t needed;
+  std::error_code ec;
+
+  explicit operator bool () const noexcept
+  {
+    return size != 0;
+  }
+};
+
+// Splits a byte stream that arrives in pieces into top-level RLP items.
+// Each call to next is given all the unconsumed input, such as the data
+// of a basic_buffer, and only looks at what arrived since the last call:
+// the header is decoded once, after which partial input costs a size
+// compare.  A complete item is validated in one pass before it is
+// returned, so rlp_item can then read it without bounds checks.
+//
+//   for (;;)
+//     {
+//       rlp_frame __f = __decoder.next (__buffer.data ());
+//       if (__f.ec)
+//         fail (__f.ec);
+//       if (!__f)
+//         break; // read at least __f.needed more bytes
+//       handle (rlp_item<const byte> (__buffer.data ().data (), __f.size));
+//       __buffer.consume (__f.size);
+//     }
+//
+// Errors leave the decoder where it was; the stream cannot be resynced.
+class rlp_frame_decoder
+{
+public:
+  explicit rlp_frame_decoder (
+      std::size_t __max_size = std::numeric_limits<std::size_t>::max (),
+      std::size_t __max_depth = rlp_default_max_depth) noexcept
+      : _M_max_size (__max_size), _M_max_depth (__max_depth), _M_frame (0)
+  {
+  }
+
+  // __input starts at the first unconsumed byte; once an item is returned
+  // the caller drops it from the front before calling again.
+  rlp_frame
+  next (byte_view __input) noexcept
+  {
+    const std::uint8_t *__p
+        = reinterpret_cast<const std::uint8_t *> (__input.data ());
+    std::size_t __n = __input.size ();
+    if (_M_frame == 0)
+      {
+        std::size_t __header = __n == 0 ? 1 : _S_header_size (__p[0]);
+        if (__n < __header)
+          return { 0, __header - __n, std::error_code () };
+        rlp_errc __e = _M_parse_header (__p, __header);
+        if (__e != rlp_errc ())
+          return { 0, 0, __e };
+      }
+    if (__n < _M_frame)
+      return { 0, _M_frame - __n, std::error_code () };
+    rlp_validate_result __r
+        = rlp_validate (byte_view (__input, _M_frame), _M_max_depth);
+    if (!__r)
+      return { 0, 0, __r.ec };
+    return { std::exchange (_M_frame, 0), 0, std::error_code () };
+  }
+
+  // Size of the item being received, header included, once its header is
+  // complete; 0 otherwise.
+  std::size_t
+  pending () const noexcept
+  {
+    return _M_frame;
+  }
+
+  // Forgets the partially received item, e.g. after the input was dropped.
+  void
+  reset () noexcept
+  {
+    _M_frame = 0;
+  }
+
+private:
+  static std::size_t
+  _S_header_size (std::uint8_t __prefix) noexcept
+  {
+    if (__prefix < 0xb8)
+      return 1;
+    if (__prefix < 0xc0)
+      return 1 + __prefix - 0xb7;
+    if (__prefix < 0xf8)
+      return 1;
+    return 1 + __prefix - 0xf7;
+  }
+
+  rlp_errc
+  _M_parse_header (const std::uint8_t *__p, std::size_t __header) noexcept
+  {
+    std::uint8_t __prefix = __p[0];
+    std::uint64_t __length;
+    if (__prefix < 0x80)
+      __length = 0;
+    else if (__header == 1)
+      __length = __prefix - (__prefix < 0xc0 ? 0x80 : 0xc0);
+    else
+      {
+        if (__p[1] == 0)
+          return rlp_errc::non_canonical_size;
+        __length = __detail::__load_be (__p + 1, __header - 1);
+        if (__length < 56)
+          return rlp_errc::non_canonical_size;
+      }
+    if (__length > _M_max_size || __header > _M_max_size - __length)
+      return rlp_errc::item_too_large;
+    _M_frame = __header + __length;
+    return rlp_errc ();
+  }
+
+  std::size_t _M_max_size;
+  std::size_t _M_max_depth;
+  std::size_t _M_frame;
+};
+
+} // namespace basic
+
+#endif //__LIBBASIC_RLP_FRAME_H__
@@ -0,0 +1,18 @@
+#ifndef __LIBBASIC_RLP_POOLED_H__
+#define __LIBBASIC_RLP_POOLED_H__
+
+#include "pool_allocator.h"
+#include "rlp.h"
+
+namespace basic
+{
+
+namespace pooled
+{
+template <typename _Byte = byte>
+using rlp_buffer = basic::rlp_buffer<_Byte, pool_allocator<_Byte> >;
+}
+
+} // namespace basic
+
+#endif //__LIBBASIC_RLP_POOLED_H__
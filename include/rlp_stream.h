@@ -0,0 +1,313 @@
+#ifndef __LIBBASIC_RLP_STREAM_H__
+#define __LIBBASIC_RLP_STREAM_H__
+
+#include "default_init_allocator.h"
+#include "rlp.h"
+#include <algorithm>
+#include <cerrno>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#define __LIBBASIC_HAS_UNISTD 1
+#endif
+
+namespace basic
+{
+
+// Where rlp_stream_writer sends its output, a byte_view at a time.
+template <typename _Sink>
+concept rlp_sink = std::invocable<_Sink &, byte_view>;
+
+#ifdef __LIBBASIC_HAS_UNISTD
+// Writes everything to a file descriptor, retrying short writes, and
+// throws std::system_error on failure.
+struct fd_sink
+{
+  int fd;
+
+  void
+  operator() (byte_view __bytes) const
+  {
+    const byte *__p = __bytes.data ();
+    std::size_t __n = __bytes.size ();
+    while (__n != 0)
+      {
+        ssize_t __r = ::write (fd, __p, __n);
+        if (__r < 0)
+          {
+            if (errno == EINTR)
+              continue;
+            throw std::system_error (errno, std::system_category (),
+                                     "fd_sink");
+          }
+        __p += __r;
+        __n -= static_cast<std::size_t> (__r);
+      }
+  }
+};
+#endif
+
+// Encodes RLP into a fixed-size buffer that is handed to _Sink whenever
+// the next write would not fit, so memory stays bounded by the high-water
+// mark whatever the size of the output.  Values that fit are encoded in
+// place in one go; larger ones are written header first and streamed,
+// with every list length measured once up front.  Lists can also be built piecewise
+// from a payload length known up front:
+//
+//   __w.begin_list (__payload_length);
+//   for (const auto &__block : __blocks)
+//     __w.put (__block);
+//   __w.end_list ();
+//   __w.flush ();
+//
+// The destructor does not flush, as the sink may throw; call flush once
+// done.
+template <rlp_sink _Sink> class rlp_stream_writer
+{
+  // Room for any list or string header, and any integer.
+  static constexpr std::size_t _S_min_high_water = 64;
+
+public:
+  explicit rlp_stream_writer (_Sink __sink,
+                              std::size_t __high_water = 64 * 1024)
+      : _M_sink (std::move (__sink)),
+        _M_buffer (std::max (__high_water, _S_min_high_water)), _M_used (0),
+        _M_flushed (0)
+  {
+  }
+
+  rlp_stream_writer (const rlp_stream_writer &) = delete;
+  rlp_stream_writer &operator= (const rlp_stream_writer &) = delete;
+
+  template <typename _Tp>
+  requires __detail::__rlp_encodable<_Tp>
+  rlp_stream_writer &
+  put (const _Tp &__val)
+  {
+    __detail::_Rlp_sizes<> __sizes;
+    std::size_t __n = __detail::__rlp_measure (__val, __sizes);
+    const std::size_t *__cursor = __sizes._M_data ();
+    _M_put (__val, __n, __cursor);
+    return *this;
+  }
+
+  // Appends __bytes, which must already be RLP encoded.
+  rlp_stream_writer &
+  put_raw (byte_view __bytes)
+  {
+    _M_append (__bytes.data (), __bytes.size ());
+    return *this;
+  }
+
+  // Opens a list whose items will take exactly __payload_length bytes;
+  // end_list checks that they did.
+  rlp_stream_writer &
+  begin_list (std::size_t __payload_length)
+  {
+    _M_put_header (__payload_length, 0xc0, 0xf7);
+    _M_lists.push_back (size () + __payload_length);
+    return *this;
+  }
+
+  rlp_stream_writer &
+  end_list ()
+  {
+    if (_M_lists.empty () || _M_lists.back () != size ())
+      throw std::logic_error ("rlp_stream_writer: list length mismatch");
+    _M_lists.pop_back ();
+    return *this;
+  }
+
+  // Hands the buffered bytes to the sink.
+  void
+  flush ()
+  {
+    if (_M_used == 0)
+      return;
+    _M_sink (byte_view (_M_buffer.data (), _M_used));
+    _M_flushed += _M_used;
+    _M_used = 0;
+  }
+
+  // Bytes written so far, flushed or not.
+  std::size_t
+  size () const noexcept
+  {
+    return _M_flushed + _M_used;
+  }
+
+  std::size_t
+  buffered () const noexcept
+  {
+    return _M_used;
+  }
+
+  std::size_t
+  high_water_mark () const noexcept
+  {
+    return _M_buffer.size ();
+  }
+
+  // Lists opened by begin_list and not yet closed.
+  std::size_t
+  open_lists () const noexcept
+  {
+    return _M_lists.size ();
+  }
+
+  _Sink &
+  sink () noexcept
+  {
+    return _M_sink;
+  }
+
+private:
+  typedef __detail::_Rlp_writer<std::uint8_t> _Writer;
+
+  std::size_t
+  _M_room () const noexcept
+  {
+    return _M_buffer.size () - _M_used;
+  }
+
+  // The encoded length of __val, whose list lengths, if any, start at
+  // __sizes.
+  template <typename _Tp>
+  static std::size_t
+  _S_length (const _Tp &__val, const std::size_t *__sizes) noexcept
+  {
+    if constexpr (rlp_described<_Tp> || __detail::__rlp_list<_Tp>)
+      return __detail::__rlp_header_length (*__sizes) + *__sizes;
+    else
+      return __detail::__rlp_length (__val);
+  }
+
+  // Writes __val, whose encoding takes __n bytes, taking the lengths of
+  // the lists in it from __sizes as __rlp_measure recorded them.
+  template <typename _Tp>
+  void
+  _M_put (const _Tp &__val, std::size_t __n, const std::size_t *&__sizes)
+  {
+    if (__n <= _M_buffer.size ())
+      {
+        if (_M_room () < __n)
+          flush ();
+        // _M_used only moves once the whole value is written, so a throw
+        // (a malformed hex string) leaves nothing behind.
+        _Writer __w{ _M_buffer.data () + _M_used, __sizes };
+        __w._M_write (__val);
+        __sizes = __w._M_sizes;
+        _M_used += __n;
+      }
+    else if constexpr (std::is_unsigned_v<_Tp>
+                       || __is_boost_multiprecision_number<_Tp>::value)
+      {
+        // Only numbers wider than the buffer get here; they are encoded
+        // whole and copied in pieces.
+        std::vector<std::uint8_t, default_init_allocator<std::uint8_t> >
+            __tmp (__n);
+        _Writer __w{ __tmp.data () };
+        __w._M_write (__val);
+        _M_append (__tmp.data (), __n);
+      }
+    else if constexpr (__detail::__rlp_string<_Tp>)
+      {
+        std::string_view __str = __detail::__rlp_string_view (__val);
+        if (__detail::__rlp_is_hex (__str))
+          _M_put_hex (__str.substr (2));
+        else
+          {
+            _M_put_header (__str.size (), 0x80, 0xb7);
+            _M_append (__str.data (), __str.size ());
+          }
+      }
+    else if constexpr (__detail::__rlp_bytes<_Tp>)
+      {
+        _M_put_header (std::ranges::size (__val), 0x80, 0xb7);
+        _M_append (std::ranges::data (__val), std::ranges::size (__val));
+      }
+    else if constexpr (rlp_described<_Tp>)
+      {
+        _M_put_header (*__sizes++, 0xc0, 0xf7);
+        __detail::__rlp_for_each_field (
+            __val, [this, &__sizes] (const auto &__field) {
+              _M_put (__field, _S_length (__field, __sizes), __sizes);
+            });
+      }
+    else if constexpr (__detail::__rlp_list<_Tp>)
+      {
+        _M_put_header (*__sizes++, 0xc0, 0xf7);
+        for (const auto &__elem : __val)
+          _M_put (__elem, _S_length (__elem, __sizes), __sizes);
+      }
+    else
+      static_assert (dependent_false<_Tp>, "type has no RLP encoding");
+  }
+
+  void
+  _M_put_header (std::size_t __n, std::uint8_t __short, std::uint8_t __long)
+  {
+    if (_M_room () < 9)
+      flush ();
+    _Writer __w{ _M_buffer.data () + _M_used };
+    __w._M_put_header (__n, __short, __long);
+    _M_used = __w._M_cur - _M_buffer.data ();
+  }
+
+  void
+  _M_append (const void *__p, std::size_t __n)
+  {
+    const std::uint8_t *__src = static_cast<const std::uint8_t *> (__p);
+    while (__n != 0)
+      {
+        if (_M_room () == 0)
+          flush ();
+        std::size_t __k = std::min (__n, _M_room ());
+        std::memcpy (_M_buffer.data () + _M_used, __src, __k);
+        _M_used += __k;
+        __src += __k;
+        __n -= __k;
+      }
+  }
+
+  // Decodes a hex string too long for the buffer a chunk at a time.  An
+  // odd digit count is taken as a leading zero, so the first chunk gets
+  // the odd digit.
+  void
+  _M_put_hex (std::string_view __digits)
+  {
+    _M_put_header ((__digits.size () + 1) / 2, 0x80, 0xb7);
+    while (!__digits.empty ())
+      {
+        if (_M_room () == 0)
+          flush ();
+        std::size_t __k = std::min (__digits.size (), 2 * _M_room ());
+        if (__k % 2 != __digits.size () % 2)
+          --__k;
+        std::size_t __bytes = (__k + 1) / 2;
+        if (!hex_decode (__digits.substr (0, __k),
+                         mutable_byte_view (_M_buffer.data () + _M_used,
+                                            __bytes)))
+          throw std::invalid_argument ("rlp: malformed hex string");
+        _M_used += __bytes;
+        __digits.remove_prefix (__k);
+      }
+  }
+
+  _Sink _M_sink;
+  std::vector<std::uint8_t, default_init_allocator<std::uint8_t> > _M_buffer;
+  std::size_t _M_used;
+  std::size_t _M_flushed;
+  std::vector<std::size_t> _M_lists;
+};
+
+} // namespace basic
+
+#endif //__LIBBASIC_RLP_STREAM_H__
@@ -0,0 +1,285 @@
+#ifndef __LIBBASIC_RLP_TAPE_H__
+#define __LIBBASIC_RLP_TAPE_H__
+
+#include "cpu.h"
+#include "rlp.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace basic
+{
+
+// One item of a scanned RLP buffer.  Entries are stored in document order,
+// so the first child of a non-empty list is the entry right after it and
+// next is the index one past its whole subtree, i.e. its next sibling.
+struct rlp_tape_entry
+{
+  std::size_t offset;      // start of the header in the input
+  std::size_t length;      // payload size
+  std::uint32_t next;      // index of the next sibling
+  std::uint16_t depth;     // 0 for top-level items
+  std::uint8_t header;     // header size
+  bool list;
+
+  std::size_t
+  size () const noexcept
+  {
+    return header + length;
+  }
+};
+
+namespace __detail
+{
+
+// Counts the bytes below 0x80 at the start of [__p, __p + __n).  Inside a
+// list each of them is a complete single-byte item, so long runs (small
+// integers, flags, packed nibbles) are skipped a vector at a time: the high
+// bit of every byte is exactly what movemask extracts.
+inline std::size_t
+__rlp_single_byte_run_scalar (const std::uint8_t *__p,
+                              std::size_t __n) noexcept
+{
+  std::size_t __i = 0;
+  while (__i != __n && __p[__i] < 0x80)
+    ++__i;
+  return __i;
+}
+
+#ifdef __LIBBASIC_X86
+__attribute__ ((target ("sse2"))) inline std::size_t
+__rlp_single_byte_run_sse2 (const std::uint8_t *__p,
+                            std::size_t __n) noexcept
+{
+  std::size_t __i = 0;
+  for (; __i + 16 <= __n; __i += 16)
+    {
+      __m128i __v = _mm_loadu_si128 (
+          reinterpret_cast<const __m128i *> (__p + __i));
+      unsigned __mask = static_cast<unsigned> (_mm_movemask_epi8 (__v));
+      if (__mask != 0)
+        return __i + std::countr_zero (__mask);
+    }
+  return __i + __rlp_single_byte_run_scalar (__p + __i, __n - __i);
+}
+
+__attribute__ ((target ("avx2"))) inline std::size_t
+__rlp_single_byte_run_avx2 (const std::uint8_t *__p,
+                            std::size_t __n) noexcept
+{
+  std::size_t __i = 0;
+  for (; __i + 32 <= __n; __i += 32)
+    {
+      __m256i __v = _mm256_loadu_si256 (
+          reinterpret_cast<const __m256i *> (__p + __i));
+      unsigned __mask = static_cast<unsigned> (_mm256_movemask_epi8 (__v));
+      if (__mask != 0)
+        return __i + std::countr_zero (__mask);
+    }
+  return __i + __rlp_single_byte_run_sse2 (__p + __i, __n - __i);
+}
+
+__attribute__ ((target ("avx512bw"))) inline std::size_t
+__rlp_single_byte_run_avx512bw (const std::uint8_t *__p,
+                                std::size_t __n) noexcept
+{
+  std::size_t __i = 0;
+  for (; __i + 64 <= __n; __i += 64)
+    {
+      __m512i __v = _mm512_loadu_si512 (__p + __i);
+      std::uint64_t __mask = _mm512_movepi8_mask (__v);
+      if (__mask != 0)
+        return __i + std::countr_zero (__mask);
+    }
+  return __i + __rlp_single_byte_run_avx2 (__p + __i, __n - __i);
+}
+#endif
+
+typedef std::size_t (*_Rlp_run_fn) (const std::uint8_t *, std::size_t);
+
+inline _Rlp_run_fn
+__rlp_select_single_byte_run () noexcept
+{
+  return cpu_select<_Rlp_run_fn> ({
+#ifdef __LIBBASIC_X86
+      { cpu_level::avx512bw, __rlp_single_byte_run_avx512bw },
+      { cpu_level::avx2, __rlp_single_byte_run_avx2 },
+      { cpu_level::sse2, __rlp_single_byte_run_sse2 },
+#endif
+      { cpu_level::scalar, __rlp_single_byte_run_scalar },
+  });
+}
+
+inline std::size_t
+__rlp_single_byte_run (const std::uint8_t *__p, std::size_t __n) noexcept
+{
+  static const _Rlp_run_fn __fn = __rlp_select_single_byte_run ();
+  return __fn (__p, __n);
+}
+
+}
+
+// A flat, validated index of every item in an RLP buffer, nested items
+// included, in the spirit of simdjson's tape.  Built once in a single pass;
+// afterwards items are reached by index without decoding any header again.
+class rlp_tape
+{
+public:
+  typedef rlp_tape_entry value_type;
+  typedef std::size_t size_type;
+  typedef std::vector<rlp_tape_entry>::const_iterator const_iterator;
+
+  // Replaces the tape with the items of __input, which must outlive it.
+  // On error the tape holds the entries scanned before the offending item.
+  // Entries record their depth in 16 bits, so __max_depth is capped at
+  // 65535, and inputs of 2^32 items or more fail with too_many_items.
+  rlp_validate_result
+  scan (byte_view __input, std::size_t __max_depth = rlp_default_max_depth)
+  {
+    __max_depth = std::min (__max_depth, _S_max_depth);
+    _M_input = __input;
+    _M_entries.clear ();
+    const std::uint8_t *__first
+        = reinterpret_cast<const std::uint8_t *> (__input.data ());
+    const std::uint8_t *__ptr = __first;
+    rlp_errc __e = _M_scan (__first, __ptr, __first + __input.size (), 0,
+                            __max_depth);
+    if (__e != rlp_errc ())
+      return { static_cast<std::size_t> (__ptr - __first), __e };
+    return { __input.size (), std::error_code () };
+  }
+
+  size_type
+  size () const noexcept
+  {
+    return _M_entries.size ();
+  }
+
+  bool
+  empty () const noexcept
+  {
+    return _M_entries.empty ();
+  }
+
+  const rlp_tape_entry &
+  operator[] (size_type __i) const noexcept
+  {
+    return _M_entries[__i];
+  }
+
+  const_iterator
+  begin () const noexcept
+  {
+    return _M_entries.begin ();
+  }
+
+  const_iterator
+  end () const noexcept
+  {
+    return _M_entries.end ();
+  }
+
+  // The index of the first child of list __i, or next (__i) if it is empty.
+  size_type
+  first_child (size_type __i) const noexcept
+  {
+    return __i + 1;
+  }
+
+  size_type
+  next (size_type __i) const noexcept
+  {
+    return _M_entries[__i].next;
+  }
+
+  // The encoded bytes of entry __i, header included.
+  template <typename _Byte = const byte>
+  rlp_item<_Byte>
+  item (size_type __i) const noexcept
+  {
+    const rlp_tape_entry &__e = _M_entries[__i];
+    return rlp_item<_Byte> (
+        reinterpret_cast<_Byte *> (_M_input.data () + __e.offset),
+        __e.size ());
+  }
+
+  void
+  clear () noexcept
+  {
+    _M_input = byte_view ();
+    _M_entries.clear ();
+  }
+
+private:
+  // next holds an index one past the entry, so it must fit in 32 bits.
+  static constexpr size_type _S_max_entries
+      = std::numeric_limits<std::uint32_t>::max ();
+  static constexpr std::size_t _S_max_depth
+      = std::numeric_limits<std::uint16_t>::max ();
+
+  rlp_errc
+  _M_scan (const std::uint8_t *__first, const std::uint8_t *&__ptr,
+           const std::uint8_t *__last, std::size_t __depth,
+           std::size_t __max_depth)
+  {
+    while (__ptr != __last)
+      {
+        if (*__ptr < 0x80)
+          {
+            std::size_t __run
+                = __detail::__rlp_single_byte_run (__ptr, __last - __ptr);
+            if (__run > _S_max_entries - _M_entries.size ())
+              return rlp_errc::too_many_items;
+            for (; __run != 0; --__run, ++__ptr)
+              _M_push (__ptr - __first, 0, 1, __depth, false);
+            continue;
+          }
+
+        __detail::_Rlp_header __h;
+        rlp_errc __e
+            = __detail::__rlp_parse_header (__ptr, __last - __ptr, __h);
+        if (__e != rlp_errc ())
+          return __e == rlp_errc::truncated && __depth != 0
+                     ? rlp_errc::overrun
+                     : __e;
+        if (__h._M_list && __depth == __max_depth)
+          return rlp_errc::depth_exceeded;
+        if (_M_entries.size () == _S_max_entries)
+          return rlp_errc::too_many_items;
+        size_type __index = _M_push (__ptr - __first, __h._M_offset,
+                                     __h._M_length, __depth, __h._M_list);
+        const std::uint8_t *__end = __ptr + __h._M_offset + __h._M_length;
+        if (__h._M_list)
+          {
+            __ptr += __h._M_offset;
+            __e = _M_scan (__first, __ptr, __end, __depth + 1, __max_depth);
+            if (__e != rlp_errc ())
+              return __e;
+            _M_entries[__index].next
+                = static_cast<std::uint32_t> (_M_entries.size ());
+          }
+        __ptr = __end;
+      }
+    return rlp_errc ();
+  }
+
+  size_type
+  _M_push (std::size_t __offset, std::size_t __header, std::size_t __length,
+           std::size_t __depth, bool __list)
+  {
+    size_type __index = _M_entries.size ();
+    _M_entries.push_back (rlp_tape_entry{
+        __offset, __length, static_cast<std::uint32_t> (__index + 1),
+        static_cast<std::uint16_t> (__depth),
+        static_cast<std::uint8_t> (__header), __list });
+    return __index;
+  }
+
+  byte_view _M_input;
+  std::vector<rlp_tape_entry> _M_entries;
+};
+
+} // namespace basic
+
+#endif //__LIBBASIC_RLP_TAPE_H__
@@ -0,0 +1,219 @@
+#ifndef __LIBBASIC_SEGMENTED_BUFFER_H__
+#define __LIBBASIC_SEGMENTED_BUFFER_H__
+
+#include "buffer_sequence.h"
+#include "byte_view.h"
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <new>
+#include <ranges>
+#include <utility>
+
+namespace basic
+{
+
+// Recycles fixed-size blocks through an intrusive free list.  Blocks in use
+// belong to their buffers; the pool must outlive every buffer drawing from
+// it and only frees the blocks handed back to it.  It is not synchronized,
+// so buffers sharing a pool must be used from one thread at a time.
+template <std::size_t _BlockSize> class block_pool
+{
+  static_assert (_BlockSize >= sizeof (void *));
+
+  struct _Free_block
+  {
+    _Free_block *_M_next;
+  };
+
+public:
+  static constexpr std::size_t block_size = _BlockSize;
+
+  block_pool () = default;
+  block_pool (const block_pool &) = delete;
+  block_pool &operator= (const block_pool &) = delete;
+
+  ~block_pool () { release (); }
+
+  byte *
+  allocate ()
+  {
+    if (_M_free == nullptr)
+      return static_cast<byte *> (::operator new (_BlockSize));
+    _Free_block *__b = _M_free;
+    _M_free = __b->_M_next;
+    --_M_free_count;
+    return reinterpret_cast<byte *> (__b);
+  }
+
+  void
+  deallocate (byte *__p) noexcept
+  {
+    _M_free = ::new (static_cast<void *> (__p)) _Free_block{ _M_free };
+    ++_M_free_count;
+  }
+
+  // Number of blocks waiting for reuse.
+  std::size_t
+  free_blocks () const noexcept
+  {
+    return _M_free_count;
+  }
+
+  // Returns the free blocks to the system.
+  void
+  release () noexcept
+  {
+    while (_M_free != nullptr)
+      {
+        _Free_block *__next = _M_free->_M_next;
+        ::operator delete (static_cast<void *> (_M_free));
+        _M_free = __next;
+      }
+    _M_free_count = 0;
+  }
+
+private:
+  _Free_block *_M_free = nullptr;
+  std::size_t _M_free_count = 0;
+};
+
+// A byte queue stored in a chain of pool blocks.  Growing appends blocks,
+// so committed bytes never move and a large payload is never copied to a
+// bigger allocation.  data and prepare return sequences of views, one per
+// block touched.
+template <std::size_t _BlockSize = 4096> class segmented_buffer
+{
+public:
+  typedef block_pool<_BlockSize> pool_type;
+  typedef std::size_t size_type;
+
+  // The pool is given explicitly so that its lifetime and the threads
+  // using it are the caller's to choose.
+  explicit segmented_buffer (pool_type &__pool) noexcept : _M_pool (&__pool)
+  {
+  }
+
+  segmented_buffer (segmented_buffer &&__x) noexcept
+      : _M_pool (__x._M_pool), _M_blocks (std::move (__x._M_blocks)),
+        _M_head (std::exchange (__x._M_head, 0)),
+        _M_size (std::exchange (__x._M_size, 0)),
+        _M_prepared (std::exchange (__x._M_prepared, 0))
+  {
+    __x._M_blocks.clear ();
+  }
+
+  segmented_buffer &operator= (segmented_buffer &&) = delete;
+
+  ~segmented_buffer () { _M_release_blocks (0); }
+
+  size_type
+  size () const noexcept
+  {
+    return _M_size;
+  }
+
+  bool
+  empty () const noexcept
+  {
+    return _M_size == 0;
+  }
+
+  // Bytes available without drawing another block.
+  size_type
+  capacity () const noexcept
+  {
+    return _M_blocks.size () * _BlockSize - _M_head;
+  }
+
+  auto
+  data () const
+  {
+    return _M_views<byte_view> (_M_head, _M_size);
+  }
+
+  // Exactly __n writable bytes after the readable ones, drawing blocks
+  // from the pool as needed.
+  auto
+  prepare (size_type __n)
+  {
+    size_type __end = _M_head + _M_size + __n;
+    while (_M_blocks.size () * _BlockSize < __end)
+      _M_blocks.push_back (_M_pool->allocate ());
+    _M_prepared = __n;
+    return _M_views<mutable_byte_view> (_M_head + _M_size, __n);
+  }
+
+  void
+  commit (size_type __n) noexcept
+  {
+    _M_size += std::min (__n, _M_prepared);
+    _M_prepared = 0;
+  }
+
+  // Hands fully read blocks back to the pool; invalidates prepared views.
+  void
+  consume (size_type __n) noexcept
+  {
+    size_type __m = std::min (__n, _M_size);
+    _M_size -= __m;
+    for (_M_head += __m; _M_head >= _BlockSize; _M_head -= _BlockSize)
+      {
+        _M_pool->deallocate (_M_blocks.front ());
+        _M_blocks.pop_front ();
+      }
+    if (_M_size == 0)
+      _M_head = 0;
+  }
+
+  void
+  clear () noexcept
+  {
+    _M_release_blocks (0);
+    _M_head = _M_size = _M_prepared = 0;
+  }
+
+  // Returns unused trailing blocks to the pool.
+  void
+  shrink_to_fit () noexcept
+  {
+    size_type __used = _M_head + _M_size + _M_prepared;
+    _M_release_blocks ((__used + _BlockSize - 1) / _BlockSize);
+  }
+
+private:
+  template <typename _View>
+  auto
+  _M_views (size_type __pos, size_type __n) const
+  {
+    size_type __first = __pos / _BlockSize;
+    size_type __last = __n == 0 ? __first : (__pos + __n - 1) / _BlockSize + 1;
+    return std::views::iota (__first, __last)
+           | std::views::transform ([this, __pos, __n] (size_type __i) {
+               size_type __begin = std::max (__pos, __i * _BlockSize);
+               size_type __end = std::min (__pos + __n, (__i + 1) * _BlockSize);
+               return _View (_M_blocks[__i] + (__begin - __i * _BlockSize),
+                             __end - __begin);
+             });
+  }
+
+  void
+  _M_release_blocks (size_type __keep) noexcept
+  {
+    while (_M_blocks.size () > __keep)
+      {
+        _M_pool->deallocate (_M_blocks.back ());
+        _M_blocks.pop_back ();
+      }
+  }
+
+  pool_type *_M_pool;
+  std::deque<byte *> _M_blocks;
+  size_type _M_head = 0;
+  size_type _M_size = 0;
+  size_type _M_prepared = 0;
+};
+
+} // namespace basic
+
+#endif //__LIBBASIC_SEGMENTED_BUFFER_H__
@@ -0,0 +1,326 @@
+#ifndef __LIBBASIC_SMALL_BYTES_H__
+#define __LIBBASIC_SMALL_BYTES_H__
+
+#include "byte.h"
+#include "byte_view.h"
+#include "type_traits.h"
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace basic
+{
+
+// A byte vector keeping up to _Nm bytes inline, so addresses, hashes and
+// short integer payloads never touch the heap.  Past _Nm it moves to a heap
+// block and grows geometrically like std::vector.  Element type is any
+// underlying byte type; new bytes are zero-initialized.
+template <std::size_t _Nm, typename _Byte = byte>
+requires is_underlying_byte_v<_Byte>
+class small_bytes
+{
+  static_assert (_Nm != 0);
+
+public:
+  typedef _Byte value_type;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef _Byte *pointer;
+  typedef const _Byte *const_pointer;
+  typedef _Byte &reference;
+  typedef const _Byte &const_reference;
+  typedef _Byte *iterator;
+  typedef const _Byte *const_iterator;
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  static constexpr size_type inline_capacity = _Nm;
+
+  small_bytes () noexcept : _M_ptr (_M_local), _M_size (0), _M_capacity (_Nm)
+  {
+  }
+
+  explicit small_bytes (size_type __n) : small_bytes () { resize (__n); }
+
+  small_bytes (size_type __n, _Byte __value) : small_bytes ()
+  {
+    resize (__n, __value);
+  }
+
+  template <std::input_iterator _It>
+  small_bytes (_It __first, _It __last) : small_bytes ()
+  {
+    assign (__first, __last);
+  }
+
+  small_bytes (std::initializer_list<_Byte> __il) : small_bytes ()
+  {
+    assign (__il.begin (), __il.end ());
+  }
+
+  explicit small_bytes (byte_view __bytes) : small_bytes ()
+  {
+    _M_assign_raw (__bytes.data (), __bytes.size ());
+  }
+
+  small_bytes (const small_bytes &__x) : small_bytes ()
+  {
+    _M_assign_raw (__x._M_ptr, __x._M_size);
+  }
+
+  small_bytes (small_bytes &&__x) noexcept : small_bytes ()
+  {
+    _M_steal (__x);
+  }
+
+  small_bytes &
+  operator= (const small_bytes &__x)
+  {
+    if (this != &__x)
+      _M_assign_raw (__x._M_ptr, __x._M_size);
+    return *this;
+  }
+
+  small_bytes &
+  operator= (small_bytes &&__x) noexcept
+  {
+    if (this != &__x)
+      {
+        _M_free ();
+        _M_ptr = _M_local;
+        _M_capacity = _Nm;
+        _M_size = 0;
+        _M_steal (__x);
+      }
+    return *this;
+  }
+
+  ~small_bytes () { _M_free (); }
+
+  template <std::input_iterator _It>
+  void
+  assign (_It __first, _It __last)
+  {
+    clear ();
+    if constexpr (std::forward_iterator<_It>)
+      reserve (static_cast<size_type> (std::distance (__first, __last)));
+    for (; __first != __last; ++__first)
+      push_back (static_cast<_Byte> (*__first));
+  }
+
+  pointer
+  data () noexcept
+  {
+    return _M_ptr;
+  }
+
+  const_pointer
+  data () const noexcept
+  {
+    return _M_ptr;
+  }
+
+  size_type
+  size () const noexcept
+  {
+    return _M_size;
+  }
+
+  size_type
+  capacity () const noexcept
+  {
+    return _M_capacity;
+  }
+
+  size_type
+  max_size () const noexcept
+  {
+    return std::numeric_limits<difference_type>::max ();
+  }
+
+  bool
+  empty () const noexcept
+  {
+    return _M_size == 0;
+  }
+
+  // Whether the bytes live in the inline storage.
+  bool
+  is_inline () const noexcept
+  {
+    return _M_ptr == _M_local;
+  }
+
+  reference
+  operator[] (size_type __i) noexcept
+  {
+    return _M_ptr[__i];
+  }
+
+  const_reference
+  operator[] (size_type __i) const noexcept
+  {
+    return _M_ptr[__i];
+  }
+
+  iterator
+  begin () noexcept
+  {
+    return _M_ptr;
+  }
+
+  const_iterator
+  begin () const noexcept
+  {
+    return _M_ptr;
+  }
+
+  iterator
+  end () noexcept
+  {
+    return _M_ptr + _M_size;
+  }
+
+  const_iterator
+  end () const noexcept
+  {
+    return _M_ptr + _M_size;
+  }
+
+  reverse_iterator
+  rbegin () noexcept
+  {
+    return reverse_iterator (end ());
+  }
+
+  const_reverse_iterator
+  rbegin () const noexcept
+  {
+    return const_reverse_iterator (end ());
+  }
+
+  reverse_iterator
+  rend () noexcept
+  {
+    return reverse_iterator (begin ());
+  }
+
+  const_reverse_iterator
+  rend () const noexcept
+  {
+    return const_reverse_iterator (begin ());
+  }
+
+  void
+  reserve (size_type __n)
+  {
+    if (__n > _M_capacity)
+      _M_reallocate (__n);
+  }
+
+  void
+  resize (size_type __n, _Byte __value = _Byte ())
+  {
+    if (__n > _M_capacity)
+      _M_reallocate (std::max (__n, 2 * _M_capacity));
+    if (__n > _M_size)
+      std::fill (_M_ptr + _M_size, _M_ptr + __n, __value);
+    _M_size = __n;
+  }
+
+  void
+  push_back (_Byte __b)
+  {
+    if (_M_size == _M_capacity)
+      _M_reallocate (2 * _M_capacity);
+    _M_ptr[_M_size++] = __b;
+  }
+
+  iterator
+  erase (const_iterator __first, const_iterator __last) noexcept
+  {
+    iterator __f = _M_ptr + (__first - _M_ptr);
+    if (__first != __last)
+      {
+        std::memmove (__f, __last, end () - __last);
+        _M_size -= __last - __first;
+      }
+    return __f;
+  }
+
+  void
+  clear () noexcept
+  {
+    _M_size = 0;
+  }
+
+  friend bool
+  operator== (const small_bytes &__x, const small_bytes &__y) noexcept
+  {
+    return __x._M_size == __y._M_size
+           && (__x._M_size == 0
+               || std::memcmp (__x._M_ptr, __y._M_ptr, __x._M_size) == 0);
+  }
+
+private:
+  void
+  _M_assign_raw (const void *__p, size_type __n)
+  {
+    clear ();
+    reserve (__n);
+    if (__n != 0)
+      std::memcpy (_M_ptr, __p, __n);
+    _M_size = __n;
+  }
+
+  void
+  _M_reallocate (size_type __n)
+  {
+    if (__n > max_size ())
+      throw std::length_error ("small_bytes");
+    _Byte *__p = std::allocator<_Byte> ().allocate (__n);
+    if (_M_size != 0)
+      std::memcpy (__p, _M_ptr, _M_size);
+    _M_free ();
+    _M_ptr = __p;
+    _M_capacity = __n;
+  }
+
+  void
+  _M_free () noexcept
+  {
+    if (!is_inline ())
+      std::allocator<_Byte> ().deallocate (_M_ptr, _M_capacity);
+  }
+
+  // Takes __x's heap block, or copies its inline bytes, leaving __x empty.
+  void
+  _M_steal (small_bytes &__x) noexcept
+  {
+    if (__x.is_inline ())
+      {
+        if (__x._M_size != 0)
+          std::memcpy (_M_local, __x._M_local, __x._M_size);
+      }
+    else
+      {
+        _M_ptr = std::exchange (__x._M_ptr, __x._M_local);
+        _M_capacity = std::exchange (__x._M_capacity, _Nm);
+      }
+    _M_size = std::exchange (__x._M_size, 0);
+  }
+
+  _Byte *_M_ptr;
+  size_type _M_size;
+  size_type _M_capacity;
+  _Byte _M_local[_Nm];
+};
+
+} // namespace basic
+
+#endif //__LIBBASIC_SMALL_BYTES_H__
@@ -0,0 +1,223 @@
+#ifndef __LIBBASIC_STATIC_BUFFER_H__
+#define __LIBBASIC_STATIC_BUFFER_H__
+
+#include "byte.h"
+#include "byte_view.h"
+#include "type_traits.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace basic
+{
+
+// A byte container with a fixed inline capacity of _Nm, for bounded
+// messages that should never touch the heap.  It satisfies
+// basic_buffer_underlying, so it can back a basic_buffer, and pairs with
+// rlp_max_length_v and rlp_encode_into for allocation-free encoding.
+// Growing past _Nm throws std::length_error.  Bytes are left
+// uninitialized until written or resized into.
+template <std::size_t _Nm, typename _Byte = byte>
+requires is_underlying_byte_v<_Byte>
+class static_buffer
+{
+public:
+  typedef _Byte value_type;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef _Byte *pointer;
+  typedef const _Byte *const_pointer;
+  typedef _Byte &reference;
+  typedef const _Byte &const_reference;
+  typedef _Byte *iterator;
+  typedef const _Byte *const_iterator;
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  static_buffer () noexcept : _M_size (0) {}
+
+  explicit static_buffer (byte_view __bytes) : static_buffer ()
+  {
+    _S_check (__bytes.size ());
+    if (!__bytes.empty ())
+      std::memcpy (_M_bytes, __bytes.data (), __bytes.size ());
+    _M_size = __bytes.size ();
+  }
+
+  static_buffer (const static_buffer &__x) noexcept : _M_size (__x._M_size)
+  {
+    if (_M_size != 0)
+      std::memcpy (_M_bytes, __x._M_bytes, _M_size);
+  }
+
+  // Only the bytes in use are copied.
+  static_buffer &
+  operator= (const static_buffer &__x) noexcept
+  {
+    if (this != &__x && __x._M_size != 0)
+      std::memcpy (_M_bytes, __x._M_bytes, __x._M_size);
+    _M_size = __x._M_size;
+    return *this;
+  }
+
+  pointer
+  data () noexcept
+  {
+    return _M_bytes;
+  }
+
+  const_pointer
+  data () const noexcept
+  {
+    return _M_bytes;
+  }
+
+  size_type
+  size () const noexcept
+  {
+    return _M_size;
+  }
+
+  static constexpr size_type
+  capacity () noexcept
+  {
+    return _Nm;
+  }
+
+  static constexpr size_type
+  max_size () noexcept
+  {
+    return _Nm;
+  }
+
+  bool
+  empty () const noexcept
+  {
+    return _M_size == 0;
+  }
+
+  bool
+  full () const noexcept
+  {
+    return _M_size == _Nm;
+  }
+
+  reference
+  operator[] (size_type __i) noexcept
+  {
+    return _M_bytes[__i];
+  }
+
+  const_reference
+  operator[] (size_type __i) const noexcept
+  {
+    return _M_bytes[__i];
+  }
+
+  iterator
+  begin () noexcept
+  {
+    return _M_bytes;
+  }
+
+  const_iterator
+  begin () const noexcept
+  {
+    return _M_bytes;
+  }
+
+  iterator
+  end () noexcept
+  {
+    return _M_bytes + _M_size;
+  }
+
+  const_iterator
+  end () const noexcept
+  {
+    return _M_bytes + _M_size;
+  }
+
+  reverse_iterator
+  rbegin () noexcept
+  {
+    return reverse_iterator (end ());
+  }
+
+  const_reverse_iterator
+  rbegin () const noexcept
+  {
+    return const_reverse_iterator (end ());
+  }
+
+  reverse_iterator
+  rend () noexcept
+  {
+    return reverse_iterator (begin ());
+  }
+
+  const_reverse_iterator
+  rend () const noexcept
+  {
+    return const_reverse_iterator (begin ());
+  }
+
+  void
+  resize (size_type __n, _Byte __value = _Byte ())
+  {
+    _S_check (__n);
+    if (__n > _M_size)
+      std::fill (_M_bytes + _M_size, _M_bytes + __n, __value);
+    _M_size = __n;
+  }
+
+  // Grows or shrinks to __n bytes, leaving new ones uninitialized; used by
+  // basic_buffer's prepare, whose bytes are about to be written.
+  void
+  resize_for_overwrite (size_type __n)
+  {
+    _S_check (__n);
+    _M_size = __n;
+  }
+
+  void
+  push_back (_Byte __b)
+  {
+    _S_check (_M_size + 1);
+    _M_bytes[_M_size++] = __b;
+  }
+
+  iterator
+  erase (const_iterator __first, const_iterator __last) noexcept
+  {
+    iterator __f = _M_bytes + (__first - _M_bytes);
+    if (__first != __last)
+      {
+        std::memmove (__f, __last, end () - __last);
+        _M_size -= __last - __first;
+      }
+    return __f;
+  }
+
+  void
+  clear () noexcept
+  {
+    _M_size = 0;
+  }
+
+private:
+  static void
+  _S_check (size_type __n)
+  {
+    if (__n > _Nm)
+      throw std::length_error ("static_buffer");
+  }
+
+  size_type _M_size;
+  _Byte _M_bytes[_Nm];
+};
+
+} // namespace basic
+
+#endif //__LIBBASIC_STATIC_BUFFER_H__
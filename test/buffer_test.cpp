@@ -0,0 +1,191 @@
+#include "buffer.h"
+#include "buffer_sequence.h"
+#include "default_init_allocator.h"
+#include "segmented_buffer.h"
+#include "static_buffer.h"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace basic;
+
+namespace
+{
+std::string
+read_all (const std::array<byte_view, 2> &segments)
+{
+  std::string s;
+  for (byte_view v : segments)
+    s.append (reinterpret_cast<const char *> (v.data ()), v.size ());
+  return s;
+}
+
+void
+write (auto &buf, std::string_view s)
+{
+  auto segments = buf.prepare (s.size ());
+  std::size_t off = 0;
+  for (auto v : segments)
+    {
+      std::memcpy (v.data (), s.data () + off, v.size ());
+      off += v.size ();
+    }
+  buf.commit (s.size ());
+}
+}
+
+TEST (BufferTest, PrepareCommitConsume)
+{
+  std::vector<unsigned char> storage;
+  basic_buffer buffer (storage);
+  auto view = buffer.prepare (5);
+  std::memcpy (view.data (), "hello", 5);
+  buffer.commit (5);
+  EXPECT_EQ (buffer.size (), 5);
+  buffer.consume (2);
+  EXPECT_EQ (buffer.size (), 3);
+  EXPECT_EQ (std::memcmp (buffer.data ().data (), "llo", 3), 0);
+}
+
+TEST (BufferTest, RingWrapsAround)
+{
+  std::vector<unsigned char> storage;
+  ring_buffer<std::vector<unsigned char> > buffer (storage);
+  std::size_t capacity = buffer.capacity ();
+  EXPECT_TRUE (std::has_single_bit (capacity));
+
+  std::string head (capacity - 4, 'a');
+  write (buffer, head);
+  buffer.consume (capacity - 8);
+  write (buffer, "0123456789");
+  std::array<byte_view, 2> segments = std::as_const (buffer).data ();
+  EXPECT_EQ (segments[0].size (), 8);
+  EXPECT_EQ (segments[1].size (), 6);
+  EXPECT_EQ (read_all (segments), "aaaa0123456789");
+  EXPECT_EQ (buffer.capacity (), capacity);
+
+  buffer.consume (6);
+  EXPECT_EQ (read_all (std::as_const (buffer).data ()), "23456789");
+  buffer.consume (8);
+  EXPECT_TRUE (buffer.empty ());
+}
+
+TEST (BufferTest, RingGrows)
+{
+  std::vector<unsigned char> storage;
+  ring_buffer<std::vector<unsigned char> > buffer (storage);
+  std::size_t capacity = buffer.capacity ();
+  write (buffer, std::string (capacity - 2, 'x'));
+  buffer.consume (capacity - 6);
+  write (buffer, "yy");
+  std::string tail (capacity, 'z');
+  write (buffer, tail);
+  EXPECT_EQ (buffer.capacity (), 2 * capacity);
+  EXPECT_EQ (read_all (std::as_const (buffer).data ()), "xxxxyy" + tail);
+}
+
+TEST (BufferTest, ByteViewArrayConsume)
+{
+  std::string a = "head", b = "payload";
+  byte_view_array<4> views;
+  EXPECT_TRUE (views.push_back (as_byte_view (a.data (), a.size ())));
+  EXPECT_TRUE (views.push_back (byte_view ()));
+  EXPECT_TRUE (views.push_back (as_byte_view (b.data (), b.size ())));
+  EXPECT_EQ (views.size (), 2);
+  EXPECT_EQ (buffer_size (views), 11);
+
+  views.consume (6);
+  EXPECT_EQ (views.size (), 1);
+  EXPECT_EQ (buffer_size (views), 5);
+  EXPECT_EQ (views[0].data (), as_byte_view (b.data (), b.size ()).data () + 2);
+}
+
+TEST (BufferTest, ChunkedBuffer)
+{
+  chunked_buffer<unsigned char> chunks;
+  chunks.append (std::vector<unsigned char>{ 1, 2, 3 });
+  std::vector<unsigned char> second = { 4, 5 };
+  const unsigned char *second_data = second.data ();
+  chunks.append (std::move (second));
+  EXPECT_EQ (chunks.size (), 5);
+  EXPECT_EQ (buffer_size (chunks.data ()), 5);
+
+  iovec iov[4];
+  EXPECT_EQ (to_iovec (chunks.data (), iov), 2);
+  EXPECT_EQ (iov[1].iov_base, second_data);
+  EXPECT_EQ (iov[1].iov_len, 2);
+
+  chunks.consume (4);
+  EXPECT_EQ (chunks.size (), 1);
+  EXPECT_EQ (to_iovec (chunks.data (), iov), 1);
+  EXPECT_EQ (*static_cast<unsigned char *> (iov[0].iov_base), 5);
+}
+
+TEST (BufferTest, SegmentedBuffer)
+{
+  block_pool<16> pool;
+  segmented_buffer<16> buffer (pool);
+  std::string text = "the quick brown fox jumps over the lazy dog";
+  write (buffer, text.substr (0, 10));
+  auto first = *buffer.data ().begin ();
+  write (buffer, text.substr (10));
+  EXPECT_EQ (buffer.size (), text.size ());
+  EXPECT_EQ ((*buffer.data ().begin ()).data (), first.data ());
+
+  std::string contents;
+  for (byte_view v : buffer.data ())
+    contents.append (reinterpret_cast<const char *> (v.data ()), v.size ());
+  EXPECT_EQ (contents, text);
+  EXPECT_EQ (std::ranges::distance (buffer.data ()), 3);
+
+  buffer.consume (20);
+  EXPECT_EQ (pool.free_blocks (), 1);
+  EXPECT_EQ (buffer_size (buffer.data ()), text.size () - 20);
+  buffer.consume (text.size ());
+  EXPECT_TRUE (buffer.empty ());
+  buffer.clear ();
+  EXPECT_EQ (pool.free_blocks (), 3);
+}
+
+TEST (BufferTest, StaticBuffer)
+{
+  static_assert (basic_buffer_underlying<static_buffer<16> >);
+  static_buffer<8, unsigned char> storage;
+  basic_buffer buffer (storage);
+  auto view = buffer.prepare (5);
+  std::memcpy (view.data (), "hello", 5);
+  buffer.commit (5);
+  buffer.consume (3);
+  EXPECT_EQ (buffer.size (), 2);
+  EXPECT_EQ (std::memcmp (buffer.data ().data (), "lo", 2), 0);
+
+  view = buffer.prepare (6);
+  EXPECT_EQ (view.size (), 6);
+  buffer.commit (6);
+  EXPECT_TRUE (storage.full ());
+  EXPECT_THROW (storage.push_back (0), std::length_error);
+}
+
+TEST (BufferTest, UninitializedGrowth)
+{
+  uninit::bytes storage;
+  basic_buffer buffer (storage);
+  std::size_t reallocations = 0;
+  for (int i = 0; i != 1000; ++i)
+    {
+      std::size_t capacity = buffer.capacity ();
+      auto view = buffer.prepare (3);
+      std::memcpy (view.data (), "abc", 3);
+      buffer.commit (3);
+      reallocations += buffer.capacity () != capacity;
+    }
+  EXPECT_EQ (buffer.size (), 3000);
+  EXPECT_LE (reallocations, 12);
+  EXPECT_EQ (std::memcmp (buffer.data ().data () + 2997, "abc", 3), 0);
+
+  std::vector<int, default_init_allocator<int> > filled (3, 7);
+  EXPECT_EQ (filled[2], 7);
+  filled.resize (5);
+  filled.push_back (0);
+  EXPECT_EQ (filled.size (), 6);
+}
@@ -0,0 +1,32 @@
+#include "byte_find.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace basic;
+
+TEST (ByteFindTest, MatchesByteViewFind)
+{
+  std::vector<unsigned char> hay (300);
+  for (std::size_t i = 0; i != hay.size (); ++i)
+    hay[i] = static_cast<unsigned char> (i % 7);
+  byte_view view (hay);
+
+  unsigned char needle[] = { 5, 6, 0, 1 };
+  byte_view n (needle, sizeof (needle));
+  EXPECT_EQ (byte_find (view, n), 5);
+  EXPECT_EQ (byte_find (view, n, 6), 12);
+  EXPECT_EQ (byte_find (view, byte_view (needle, 1), 290), 292);
+  EXPECT_EQ (byte_find (view, byte_view ()), 0);
+  EXPECT_EQ (byte_find (view, n, 301), byte_view::npos);
+
+  // The only match straddles the last full vector block.
+  hay[280] = 0xaa;
+  hay[281] = 0xbb;
+  hay[282] = 0xcc;
+  unsigned char marker[] = { 0xaa, 0xbb, 0xcc };
+  byte_view m (marker, sizeof (marker));
+  EXPECT_EQ (byte_find (view, m), 280);
+  EXPECT_EQ (byte_find (view, m), view.find (m));
+  marker[2] = 0xcd;
+  EXPECT_EQ (byte_find (view, m), byte_view::npos);
+}
@@ -7,11 +7,11 @@ using namespace basic;
 
 TEST (ByteViewTest, IsByteLike)
 {
-  static_assert (is_byte_like_v<unsigned char>);
-  static_assert (is_byte_like_v<char>);
-  static_assert (is_byte_like_v<signed char>);
-  static_assert (!is_byte_like_v<int>);
-  static_assert (is_byte_like_v<std::byte>);
+  static_assert (is_underlying_byte_v<unsigned char>);
+  static_assert (is_underlying_byte_v<char>);
+  static_assert (is_underlying_byte_v<signed char>);
+  static_assert (!is_underlying_byte_v<int>);
+  static_assert (is_underlying_byte_v<std::byte>);
 }
 
 TEST (ByteViewTest, BasicByteViewConstructor)
@@ -127,4 +127,55 @@ TEST (ByteViewTest, InvalidSubviewConstruction)
   //     threw_exception = true;
   //   }
   // EXPECT_TRUE (threw_exception);
-}
\ No newline at end of file
+}
+TEST (ByteViewTest, CompareAndHash)
+{
+  unsigned char a[] = { 0x01, 0x02, 0x03 };
+  unsigned char b[] = { 0x01, 0x02, 0x03, 0x00 };
+  unsigned char c[] = { 0x01, 0x82 };
+  byte_view va (a, sizeof (a));
+  byte_view vb (b, sizeof (b));
+  byte_view vc (c, sizeof (c));
+
+  EXPECT_EQ (va, byte_view (vb, 3));
+  EXPECT_NE (va, vb);
+  EXPECT_LT (va, vb);
+  EXPECT_LT (va, vc);
+  EXPECT_GT (vc, vb);
+  EXPECT_EQ (mutable_byte_view (a, sizeof (a)), va);
+  EXPECT_TRUE (vb.starts_with (va));
+  EXPECT_FALSE (va.starts_with (vb));
+  EXPECT_TRUE (vb.ends_with (byte_view (b + 2, 2)));
+
+  std::hash<byte_view> hash;
+  EXPECT_EQ (hash (va), hash (byte_view (vb, 3)));
+  EXPECT_NE (hash (va), hash (vb));
+}
+
+TEST (ByteViewTest, Find)
+{
+  std::vector<unsigned char> hay (300);
+  for (std::size_t i = 0; i != hay.size (); ++i)
+    hay[i] = static_cast<unsigned char> (i % 7);
+  byte_view view (hay);
+
+  unsigned char needle[] = { 5, 6, 0, 1 };
+  EXPECT_EQ (view.find (byte_view (needle, sizeof (needle))), 5);
+  EXPECT_EQ (view.find (byte_view (needle, sizeof (needle)), 6), 12);
+  EXPECT_EQ (view.find (byte_view (needle, 1), 290), 292);
+  EXPECT_EQ (view.find (std::byte{ 6 }, 7), 13);
+  EXPECT_EQ (view.find (std::byte{ 7 }), byte_view::npos);
+  EXPECT_EQ (view.find (byte_view ()), 0);
+
+  // The only match straddles the last full vector block.
+  hay[280] = 0xaa;
+  hay[281] = 0xbb;
+  hay[282] = 0xcc;
+  unsigned char marker[] = { 0xaa, 0xbb, 0xcc };
+  EXPECT_EQ (view.find (byte_view (marker, sizeof (marker))), 280);
+  EXPECT_TRUE (view.contains (byte_view (marker, 2)));
+  marker[2] = 0xcd;
+  EXPECT_EQ (view.find (byte_view (marker, sizeof (marker))), byte_view::npos);
+  EXPECT_EQ (view.find (byte_view (marker, sizeof (marker)), 301),
+             byte_view::npos);
+}
@@ -0,0 +1,70 @@
+#include "cpu.h"
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+using namespace basic;
+
+namespace
+{
+int level_scalar () { return int (cpu_level::scalar); }
+int level_sse2 () { return int (cpu_level::sse2); }
+int level_avx2 () { return int (cpu_level::avx2); }
+int level_avx512bw () { return int (cpu_level::avx512bw); }
+}
+
+TEST (CpuTest, SelectBestAllowed)
+{
+  typedef int (*level_fn) ();
+  level_fn fn = cpu_select<level_fn> ({
+      { cpu_level::scalar, level_scalar },
+      { cpu_level::avx512bw, level_avx512bw },
+      { cpu_level::sse2, level_sse2 },
+      { cpu_level::avx2, level_avx2 },
+  });
+  ASSERT_NE (fn, nullptr);
+  cpu_level level = cpu_dispatch_level ();
+  cpu_level expected = level >= cpu_level::avx512bw ? cpu_level::avx512bw
+                       : level >= cpu_level::avx2   ? cpu_level::avx2
+                       : level >= cpu_level::sse2   ? cpu_level::sse2
+                                                    : cpu_level::scalar;
+  EXPECT_EQ (fn (), int (expected));
+
+  fn = cpu_select<level_fn> ({ { cpu_level::scalar, level_scalar } });
+  EXPECT_EQ (fn (), int (cpu_level::scalar));
+}
+
+TEST (CpuTest, SelectNothingAllowed)
+{
+  typedef int (*level_fn) ();
+  if (cpu_dispatch_level () >= cpu_level::avx512bw)
+    GTEST_SKIP ();
+  level_fn fn = cpu_select<level_fn> (
+      { { cpu_level::avx512bw, level_avx512bw } });
+  EXPECT_EQ (fn, nullptr);
+}
+
+TEST (CpuTest, EnvironmentOverride)
+{
+  typedef int (*level_fn) ();
+  std::initializer_list<std::pair<cpu_level, level_fn> > impls = {
+    { cpu_level::scalar, level_scalar },
+    { cpu_level::sse2, level_sse2 },
+    { cpu_level::avx2, level_avx2 },
+    { cpu_level::avx512bw, level_avx512bw },
+  };
+  cpu_level probed = __detail::__cpu_probe ();
+
+  ::setenv ("LIBBASIC_CPU", "scalar", 1);
+  cpu_level level = __detail::__cpu_select_level ();
+  EXPECT_EQ (level, cpu_level::scalar);
+  EXPECT_EQ (__detail::__cpu_select_for (level, impls) (),
+             int (cpu_level::scalar));
+
+  // The override only lowers the level; unknown names are ignored.
+  ::setenv ("LIBBASIC_CPU", "avx512bw", 1);
+  EXPECT_EQ (__detail::__cpu_select_level (), probed);
+  ::setenv ("LIBBASIC_CPU", "neon", 1);
+  EXPECT_EQ (__detail::__cpu_select_level (), probed);
+  ::unsetenv ("LIBBASIC_CPU");
+  EXPECT_EQ (__detail::__cpu_select_level (), probed);
+}
@@ -0,0 +1,52 @@
+#include "fixed_bytes.h"
+#include "rlp.h"
+#include <gtest/gtest.h>
+#include <unordered_set>
+
+using namespace basic;
+
+TEST (FixedBytesTest, HexAndCompare)
+{
+  constexpr h160 address
+      = h160::from_hex ("0x35353535353535353535353535353535353535ff");
+  static_assert (address[19] == byte{ 0xff });
+  static_assert (sizeof (h160) == 20 && alignof (h256) == 32);
+  static_assert (std::is_trivially_copyable_v<h256>);
+
+  h256 a = h256::from_hex (std::string (64, '0'));
+  h256 b = a;
+  EXPECT_TRUE (a.is_zero ());
+  EXPECT_EQ (a, b);
+  b[31] = byte{ 1 };
+  EXPECT_LT (a, b);
+  b[0] = byte{ 1 };
+  a[31] = byte{ 2 };
+  EXPECT_GT (b, a);
+  EXPECT_THROW (h256::from_hex ("0x12"), std::invalid_argument);
+  EXPECT_THROW (h160::from_hex (std::string (40, 'g')), std::invalid_argument);
+
+  std::unordered_set<h256> set = { a, b };
+  EXPECT_EQ (set.size (), 2);
+  EXPECT_EQ (set.count (b), 1);
+}
+
+TEST (FixedBytesTest, RoundTrip)
+{
+  h256 hash = h256::from_hex (
+      "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+  byte_view view = as_byte_view (hash);
+  EXPECT_EQ (view.size (), 32);
+  EXPECT_EQ (h256::from_view (view), hash);
+  EXPECT_EQ (std::hash<h256> () (hash), std::hash<byte_view> () (view));
+  EXPECT_THROW (h160::from_hex (std::string (39, '0') + "g"),
+                std::invalid_argument);
+
+  rlp_buffer<std::uint8_t> encoded;
+  encoded.put (hash);
+  EXPECT_EQ (encoded.size (), 33);
+  static_assert (rlp_max_length_v<h256> == 33);
+
+  rlp_item<const std::uint8_t> item (encoded.data (), encoded.size ());
+  EXPECT_EQ (item.to_value<h256> (), hash);
+  EXPECT_THROW (item.to_value<h160> (), std::bad_cast);
+}
@@ -0,0 +1,71 @@
+#include "hex.h"
+#include "rlp.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace basic;
+
+TEST (HexTest, EncodeDecodeRoundTrip)
+{
+  std::mt19937 rng (42);
+  for (std::size_t n = 0; n != 200; ++n)
+    {
+      std::vector<std::uint8_t> bytes (n);
+      for (auto &b : bytes)
+        b = static_cast<std::uint8_t> (rng ());
+
+      std::string hex = to_hex (as_byte_view (bytes));
+      std::string expected;
+      for (std::uint8_t b : bytes)
+        {
+          expected += "0123456789abcdef"[b >> 4];
+          expected += "0123456789abcdef"[b & 0xf];
+        }
+      ASSERT_EQ (hex, expected);
+
+      for (auto &c : hex)
+        if (rng () % 2)
+          c = static_cast<char> (std::toupper (c));
+      std::vector<std::uint8_t> decoded (n);
+      hex_decode_result r = hex_decode (hex, as_byte_view (decoded));
+      ASSERT_TRUE (r);
+      ASSERT_EQ (r.ptr, hex.data () + hex.size ());
+      ASSERT_EQ (decoded, bytes);
+    }
+}
+
+TEST (HexTest, DecodeErrors)
+{
+  std::vector<std::uint8_t> out (64);
+  for (std::size_t pos : { 0, 1, 37, 90, 127 })
+    {
+      std::string hex (128, 'a');
+      hex[pos] = 'g';
+      hex_decode_result r = hex_decode (hex, as_byte_view (out));
+      EXPECT_EQ (r.ec, std::errc::invalid_argument);
+      EXPECT_EQ (r.ptr, hex.data () + pos);
+    }
+  EXPECT_EQ (hex_decode ("abc", as_byte_view (out.data (), 1)).ec,
+             std::errc::value_too_large);
+  EXPECT_TRUE (hex_decode ("abc", as_byte_view (out)));
+  EXPECT_EQ (out[0], 0x0a);
+  EXPECT_EQ (out[1], 0xbc);
+}
+
+TEST (HexTest, RlpHexStrings)
+{
+  rlp_buffer<std::uint8_t> buffer;
+  buffer.put ("0x0400").put (std::string ("0x7f")).put ("0x").put ("dog");
+  std::vector<std::uint8_t> expected
+      = { 0x82, 0x04, 0x00, 0x7f, 0x80, 0x83, 'd', 'o', 'g' };
+  EXPECT_EQ (std::vector<std::uint8_t> (buffer.begin (), buffer.end ()),
+             expected);
+  EXPECT_EQ (rlp_length ("0x0400"), 3);
+  EXPECT_EQ (rlp_length ("0x1"), 1);
+
+  std::size_t size = buffer.size ();
+  EXPECT_THROW (buffer.put ("0xzz"), std::invalid_argument);
+  EXPECT_THROW (buffer.putl (std::vector<std::string>{ "0x01", "0xq1" }),
+                std::invalid_argument);
+  EXPECT_EQ (buffer.size (), size);
+}
@@ -0,0 +1,63 @@
+#include "mapped_file.h"
+#include "rlp.h"
+#include <fstream>
+#include <gtest/gtest.h>
+
+using namespace basic;
+
+namespace
+{
+std::filesystem::path
+write_temp (const char *name, const void *data, std::size_t n)
+{
+  std::filesystem::path path = std::filesystem::temp_directory_path () / name;
+  std::ofstream out (path, std::ios::binary | std::ios::trunc);
+  out.write (static_cast<const char *> (data), n);
+  return path;
+}
+}
+
+TEST (MappedFileTest, WalkRlpItems)
+{
+  rlp_buffer<std::uint8_t> buffer;
+  for (unsigned i = 0; i != 1000; ++i)
+    buffer.putl (std::vector<unsigned>{ i, i * 1000 });
+  std::filesystem::path path
+      = write_temp ("libbasic_mapped", buffer.data (), buffer.size ());
+
+  mapped_file_options options;
+  options.willneed = true;
+  options.huge_pages = true;
+  mapped_file file (path, options);
+  ASSERT_TRUE (file.is_open ());
+  EXPECT_EQ (file.as_byte_view (), byte_view (buffer.data (), buffer.size ()));
+
+  unsigned i = 0;
+  for (auto item : rlp_item_view<const std::byte> (file.data (), file.size ()))
+    {
+      EXPECT_EQ (item.sub_item (1).to_value<unsigned> (), i * 1000);
+      ++i;
+    }
+  EXPECT_EQ (i, 1000);
+  file.prefetch (100, 5000);
+  file.evict (0, file.size ());
+  EXPECT_EQ (file.as_byte_view (), byte_view (buffer.data (), buffer.size ()));
+
+  mapped_file moved (std::move (file));
+  EXPECT_FALSE (file.is_open ());
+  EXPECT_EQ (moved.size (), buffer.size ());
+  std::filesystem::remove (path);
+}
+
+TEST (MappedFileTest, EmptyAndMissing)
+{
+  std::filesystem::path path = write_temp ("libbasic_mapped_empty", "", 0);
+  mapped_file file (path);
+  EXPECT_TRUE (file.is_open ());
+  EXPECT_TRUE (file.as_byte_view ().empty ());
+  std::filesystem::remove (path);
+
+  EXPECT_EQ (file.open (path), std::errc::no_such_file_or_directory);
+  EXPECT_FALSE (file.is_open ());
+  EXPECT_THROW (mapped_file{ path }, std::system_error);
+}
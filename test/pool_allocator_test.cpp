@@ -0,0 +1,54 @@
+#include "buffer.h"
+#include "pool_allocator.h"
+#include "rlp_pooled.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace basic;
+
+TEST (PoolAllocatorTest, ReusesBlocks)
+{
+  pool_stats before = size_class_pool::thread_stats ();
+  void *p = size_class_pool::allocate (100);
+  size_class_pool::deallocate (p, 100);
+  void *q = size_class_pool::allocate (128);
+  EXPECT_EQ (p, q);
+  size_class_pool::deallocate (q, 128);
+
+  pool_stats after = size_class_pool::thread_stats ();
+  EXPECT_EQ (after.allocations - before.allocations, 2);
+  EXPECT_EQ (after.deallocations - before.deallocations, 2);
+  EXPECT_GT (size_class_pool::reserved_bytes (), 0);
+}
+
+TEST (PoolAllocatorTest, LargeAndCrossThread)
+{
+  pool_stats before = size_class_pool::thread_stats ();
+  pooled::bytes large (1 << 20);
+  EXPECT_EQ (size_class_pool::thread_stats ().large_allocations
+                 - before.large_allocations,
+             1);
+
+  std::vector<pooled::bytes> messages;
+  for (int i = 0; i != 1000; ++i)
+    messages.emplace_back (64, byte{ 1 });
+  std::thread consumer ([&messages] { messages.clear (); });
+  consumer.join ();
+  EXPECT_TRUE (messages.empty ());
+}
+
+TEST (PoolAllocatorTest, Containers)
+{
+  pooled::rlp_buffer<std::uint8_t> encoded;
+  encoded.putl (std::vector<std::string>{ "cat", "dog" });
+  rlp_buffer<std::uint8_t> expected;
+  expected.putl (std::vector<std::string>{ "cat", "dog" });
+  EXPECT_TRUE (std::equal (encoded.begin (), encoded.end (),
+                           expected.begin (), expected.end ()));
+
+  std::vector<unsigned char, pool_allocator<unsigned char> > storage;
+  basic_buffer buffer (storage);
+  buffer.prepare (3);
+  buffer.commit (3);
+  EXPECT_EQ (buffer.size (), 3);
+}
@@ -0,0 +1,65 @@
+#include "buffer.h"
+#include "rlp_frame.h"
+#include <gtest/gtest.h>
+
+using namespace basic;
+
+TEST (RlpFrameTest, FeedByteByByte)
+{
+  rlp_buffer<std::uint8_t> encoded;
+  std::string blob (1000, 'x');
+  encoded.put (7u).put (blob).putl (std::vector<unsigned>{ 1, 2, 300 });
+
+  std::vector<std::uint8_t> storage;
+  basic_buffer buffer (storage);
+  rlp_frame_decoder decoder;
+  std::vector<std::size_t> sizes;
+  std::vector<std::size_t> needed;
+  for (std::uint8_t b : encoded)
+    {
+      auto view = buffer.prepare (1);
+      view[0] = std::byte{ b };
+      buffer.commit (1);
+      for (;;)
+        {
+          rlp_frame frame = decoder.next (buffer.data ());
+          ASSERT_FALSE (frame.ec);
+          if (!frame)
+            {
+              needed.push_back (frame.needed);
+              break;
+            }
+          sizes.push_back (frame.size);
+          buffer.consume (frame.size);
+        }
+    }
+  EXPECT_TRUE (buffer.empty ());
+  EXPECT_EQ (sizes, (std::vector<std::size_t>{ 1, 1003, 6 }));
+
+  // 0xb9 0x03 0xe8: the header of the blob is known after its third byte.
+  EXPECT_EQ (needed[1], 2);
+  EXPECT_EQ (needed[2], 1);
+  EXPECT_EQ (needed[3], 1000);
+  EXPECT_EQ (needed[4], 999);
+}
+
+TEST (RlpFrameTest, Errors)
+{
+  std::vector<std::uint8_t> bytes = { 0xb8, 0x05 };
+  rlp_frame_decoder decoder;
+  EXPECT_EQ (decoder.next (byte_view (bytes)).ec,
+             rlp_errc::non_canonical_size);
+
+  bytes = { 0xc2, 0x81, 0x05 };
+  EXPECT_EQ (decoder.next (byte_view (bytes)).ec,
+             rlp_errc::non_canonical_single_byte);
+
+  rlp_frame_decoder limited (64);
+  bytes = { 0xb8, 0x40 };
+  EXPECT_EQ (limited.next (byte_view (bytes)).ec, rlp_errc::item_too_large);
+  bytes = { 0xc1 };
+  rlp_frame frame = limited.next (byte_view (bytes));
+  EXPECT_FALSE (frame);
+  EXPECT_EQ (frame.needed, 1);
+  EXPECT_EQ (limited.pending (), 2);
+}
@@ -0,0 +1,88 @@
+#include "rlp_stream.h"
+#include <gtest/gtest.h>
+
+using namespace basic;
+
+namespace
+{
+struct collect
+{
+  std::vector<std::uint8_t> *out;
+  std::size_t *largest;
+
+  void
+  operator() (byte_view bytes) const
+  {
+    auto p = reinterpret_cast<const std::uint8_t *> (bytes.data ());
+    out->insert (out->end (), p, p + bytes.size ());
+    *largest = std::max (*largest, bytes.size ());
+  }
+};
+}
+
+TEST (RlpStreamTest, MatchesBuffer)
+{
+  std::vector<std::string> words (50, std::string (40, 'w'));
+  std::string blob (1000, 'b');
+  std::string hex = "0x" + std::string (301, 'a');
+  std::vector<std::vector<unsigned> > rows (20, { 1, 300, 70000 });
+
+  rlp_buffer<std::uint8_t> expected;
+  expected.put (5u).putl (words).put (blob).put (hex).putl (rows);
+
+  std::vector<std::uint8_t> out;
+  std::size_t largest = 0;
+  rlp_stream_writer writer (collect{ &out, &largest }, 100);
+  writer.put (5u).put (words).put (blob).put (hex).put (rows);
+  writer.flush ();
+
+  EXPECT_EQ (writer.size (), expected.size ());
+  EXPECT_LE (largest, 100);
+  EXPECT_TRUE (std::equal (out.begin (), out.end (), expected.begin (),
+                           expected.end ()));
+}
+
+TEST (RlpStreamTest, PiecewiseList)
+{
+  std::vector<unsigned> values (100);
+  for (unsigned i = 0; i != values.size (); ++i)
+    values[i] = i * 977;
+
+  rlp_buffer<std::uint8_t> expected;
+  expected.putl (values);
+
+  std::vector<std::uint8_t> out;
+  std::size_t largest = 0;
+  rlp_stream_writer writer (collect{ &out, &largest }, 64);
+  writer.begin_list (rlp_list_length (values) - 3);
+  for (unsigned v : values)
+    writer.put (v);
+  writer.end_list ().flush ();
+  EXPECT_EQ (writer.open_lists (), 0);
+  EXPECT_TRUE (std::equal (out.begin (), out.end (), expected.begin (),
+                           expected.end ()));
+
+  writer.begin_list (2).put (1u);
+  EXPECT_THROW (writer.end_list (), std::logic_error);
+}
+
+TEST (RlpStreamTest, NumbersWiderThanBuffer)
+{
+  bigint wide = bigint (1) << 1000;
+  std::vector<bigint> numbers = { 1, wide, 300 };
+
+  rlp_buffer<std::uint8_t> expected;
+  expected.put (wide).putl (numbers);
+
+  std::vector<std::uint8_t> out;
+  std::size_t largest = 0;
+  rlp_stream_writer writer (collect{ &out, &largest }, 64);
+  writer.put (wide).put (numbers);
+  writer.flush ();
+
+  EXPECT_EQ (rlp_length (wide), 128);
+  EXPECT_EQ (writer.size (), expected.size ());
+  EXPECT_LE (largest, 64);
+  EXPECT_TRUE (std::equal (out.begin (), out.end (), expected.begin (),
+                           expected.end ()));
+}
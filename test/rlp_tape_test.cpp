@@ -0,0 +1,50 @@
+#include "rlp_tape.h"
+#include <gtest/gtest.h>
+
+using namespace basic;
+
+TEST (RlpTapeTest, ScanNested)
+{
+  std::vector<std::uint8_t> small (100, 0x01);
+  std::vector<std::vector<std::string> > words = { { "cat", "dog" }, {} };
+  rlp_buffer<std::uint8_t> buffer;
+  buffer.putl (words).putl (std::vector<unsigned> (small.begin (), small.end ()))
+      .put (1024u);
+
+  rlp_tape tape;
+  rlp_validate_result result = tape.scan (as_byte_view (buffer));
+  ASSERT_TRUE (result);
+  // [[cat, dog], []], [1 x 100], 1024
+  ASSERT_EQ (tape.size (), 5 + 1 + 100 + 1);
+
+  EXPECT_TRUE (tape[0].list);
+  EXPECT_EQ (tape.next (0), 5);
+  EXPECT_EQ (tape[tape.first_child (0)].depth, 1);
+  EXPECT_EQ (tape.next (1), 4);
+  EXPECT_EQ (tape.item (2).to_value<std::string> (), "cat");
+  EXPECT_EQ (tape[3].depth, 2);
+  EXPECT_EQ (tape.next (4), 5);
+
+  EXPECT_EQ (tape.next (5), 106);
+  for (std::size_t i = 6; i < 106; ++i)
+    {
+      EXPECT_EQ (tape[i].size (), 1);
+      EXPECT_EQ (tape.next (i), i + 1);
+    }
+  EXPECT_EQ (tape.item (106).to_value<unsigned> (), 1024);
+}
+
+TEST (RlpTapeTest, ScanRejectsMalformed)
+{
+  std::vector<std::uint8_t> bytes = { 0xc3, 0x01, 0x82, 0x02 };
+  rlp_tape tape;
+  rlp_validate_result result = tape.scan (as_byte_view (bytes));
+  EXPECT_EQ (result.ec, rlp_errc::overrun);
+  EXPECT_EQ (result.offset, 2);
+
+  bytes = { 0x01, 0xc5, 0x01 };
+  result = tape.scan (as_byte_view (bytes));
+  EXPECT_EQ (result.ec, rlp_errc::truncated);
+  EXPECT_EQ (result.offset, 1);
+  EXPECT_EQ (tape.size (), 1);
+}
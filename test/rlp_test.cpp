@@ -0,0 +1,436 @@
+#include "buffer.h"
+#include "rlp.h"
+#include "static_buffer.h"
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace basic;
+
+namespace
+{
+struct legacy_tx
+{
+  std::uint64_t nonce;
+  uint256 gas_price;
+  std::uint64_t gas;
+  byte_view to;
+  uint256 value;
+  byte_view data;
+};
+
+struct tagged
+{
+  std::array<std::uint8_t, 4> tag;
+};
+
+// Counts the allocations passed on to the default resource.
+struct counting_resource : std::pmr::memory_resource
+{
+  std::size_t allocations = 0;
+
+  void *
+  do_allocate (std::size_t bytes, std::size_t align) override
+  {
+    ++allocations;
+    return std::pmr::new_delete_resource ()->allocate (bytes, align);
+  }
+
+  void
+  do_deallocate (void *p, std::size_t bytes, std::size_t align) override
+  {
+    std::pmr::new_delete_resource ()->deallocate (p, bytes, align);
+  }
+
+  bool
+  do_is_equal (const std::pmr::memory_resource &other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+}
+
+template <> struct basic::rlp_schema<legacy_tx>
+{
+  static constexpr auto fields
+      = std::tuple (&legacy_tx::nonce, &legacy_tx::gas_price, &legacy_tx::gas,
+                    &legacy_tx::to, &legacy_tx::value, &legacy_tx::data);
+};
+
+template <> struct basic::rlp_schema<tagged>
+{
+  static constexpr auto fields = std::tuple (&tagged::tag);
+};
+
+TEST (RlpTest, ListIndexRandomAccess)
+{
+  rlp_buffer<std::uint8_t> buffer;
+  std::vector<unsigned> values = { 1, 2, 300, 4, 0x10000 };
+  buffer.putl (values);
+
+  rlp_item<const std::uint8_t> list (buffer.data (), buffer.size ());
+  EXPECT_EQ (list.items_size (), values.size ());
+  EXPECT_EQ (list.sub_item (2).to_value<unsigned> (), 300);
+  EXPECT_THROW (list.sub_item (5), std::bad_cast);
+
+  rlp_list_index<const std::uint8_t, 2> index (list);
+  ASSERT_EQ (index.size (), values.size ());
+  for (std::size_t i = 0; i < values.size (); ++i)
+    EXPECT_EQ (index[i].to_value<unsigned> (), values[i]);
+  EXPECT_THROW (index.at (5), std::out_of_range);
+
+  std::size_t arena[8];
+  rlp_list_index<const std::uint8_t> arena_index (list, arena);
+  ASSERT_EQ (arena_index.size (), values.size ());
+  EXPECT_EQ (arena_index[4].to_value<unsigned> (), 0x10000);
+
+  // Items compare by content, not by where they are stored.
+  rlp_buffer<std::uint8_t> copy;
+  copy.put (300u);
+  rlp_item<const std::uint8_t> item (copy.data (), copy.size ());
+  EXPECT_EQ (index[2], item);
+  EXPECT_NE (index[1], item);
+  EXPECT_LT (index[1], item);
+}
+
+TEST (RlpTest, MalformedListWalk)
+{
+  // Children claiming more bytes than their list holds.
+  const std::uint8_t overrun[] = { 0xc2, 0x83, 0x01 };
+  rlp_item<const std::uint8_t> list (overrun, sizeof (overrun));
+  EXPECT_THROW (list.items_size (), std::bad_cast);
+  EXPECT_THROW (list.sub_item (0), std::bad_cast);
+  EXPECT_THROW ((rlp_list_index<const std::uint8_t> (list)), std::bad_cast);
+  EXPECT_THROW (list.children ().begin (), std::bad_cast);
+  EXPECT_THROW ((rlp_item_iterator<const std::uint8_t> (overrun + 1, 2)),
+                std::bad_cast);
+
+  // A list header claiming more bytes than the item holds.
+  const std::uint8_t short_list[] = { 0xc5, 0x01 };
+  rlp_item<const std::uint8_t> cut (short_list, sizeof (short_list));
+  EXPECT_THROW (cut.payload (), std::bad_cast);
+  EXPECT_THROW (cut.items_size (), std::bad_cast);
+  EXPECT_THROW (cut.sub_item (0), std::bad_cast);
+
+  const std::uint8_t long_header[] = { 0xc2, 0xb9, 0x01 };
+  rlp_item<const std::uint8_t> truncated (long_header, sizeof (long_header));
+  EXPECT_THROW (truncated.items_size (), std::bad_cast);
+  EXPECT_THROW (truncated.to_value<std::vector<unsigned> > (), std::bad_cast);
+}
+
+TEST (RlpTest, ListToRange)
+{
+  rlp_buffer<std::uint8_t> buffer;
+  std::vector<unsigned> values = { 7, 0, 255, 1024 };
+  buffer.putl (values);
+
+  rlp_item<const std::uint8_t> list (buffer.data (), buffer.size ());
+  EXPECT_EQ (list.to_value<std::vector<unsigned> > (), values);
+
+  const std::vector<std::byte> raw (
+      reinterpret_cast<const std::byte *> (buffer.data ()),
+      reinterpret_cast<const std::byte *> (buffer.data () + buffer.size ()));
+  rlp_item<const std::byte> byte_list (raw.data (), raw.size ());
+  EXPECT_EQ (byte_list.items_size (), values.size ());
+  EXPECT_EQ (byte_list.sub_item (3).to_value<unsigned> (), 1024);
+}
+
+TEST (RlpTest, ChildrenView)
+{
+  using view_type = rlp_item_view<const std::uint8_t>;
+  static_assert (std::ranges::forward_range<view_type>);
+  static_assert (std::ranges::borrowed_range<view_type>);
+  static_assert (std::ranges::view<view_type>);
+
+  rlp_buffer<std::uint8_t> buffer;
+  std::vector<unsigned> values = { 1, 2, 300, 4 };
+  buffer.putl (values);
+
+  rlp_item<const std::uint8_t> list (buffer.data (), buffer.size ());
+  std::vector<unsigned> decoded;
+  std::ranges::copy (list.children () | std::views::transform ([] (auto item) {
+                       return item.template to_value<unsigned> ();
+                     }),
+                     std::back_inserter (decoded));
+  EXPECT_EQ (decoded, values);
+  EXPECT_TRUE (list.sub_item (0).children ().empty ());
+
+  std::size_t count = 0;
+  rlp_item_iterator<std::uint8_t> first (buffer.data (), buffer.size ()), last;
+  for (; first != last; ++first)
+    ++count;
+  EXPECT_EQ (count, 1);
+}
+
+TEST (RlpTest, ExactLengthEncoding)
+{
+  rlp_buffer<std::uint8_t> buffer;
+  buffer.put (0u).put (15u).put (1024u).put ("dog").put (std::string (56, 'a'));
+  buffer.put (bigint (0)).put (uint256 (0x10203));
+
+  std::vector<std::uint8_t> expected = { 0x80, 0x0f, 0x82, 0x04, 0x00, 0x83,
+                                         'd',  'o',  'g',  0xb8, 0x38 };
+  expected.insert (expected.end (), 56, 'a');
+  expected.insert (expected.end (), { 0x80, 0x83, 0x01, 0x02, 0x03 });
+  EXPECT_TRUE (std::ranges::equal (buffer, expected));
+
+  std::vector<std::vector<unsigned> > nested = { {}, { 1 }, { 2, 3 } };
+  rlp_buffer<std::uint8_t> list;
+  list.putl (nested);
+  std::vector<std::uint8_t> nested_expected
+      = { 0xc6, 0xc0, 0xc1, 0x01, 0xc2, 0x02, 0x03 };
+  EXPECT_TRUE (std::ranges::equal (list, nested_expected));
+  EXPECT_EQ (rlp_list_length (nested), nested_expected.size ());
+
+  // More nested lists than _Rlp_sizes keeps inline.
+  std::vector<std::vector<unsigned> > wide;
+  for (unsigned i = 1; i <= 12; ++i)
+    wide.push_back ({ i });
+  rlp_buffer<std::uint8_t> wide_list;
+  wide_list.put (wide);
+  ASSERT_EQ (wide_list.size (), 25);
+  EXPECT_EQ (wide_list[0], 0xd8);
+  EXPECT_EQ (wide_list[23], 0xc1);
+  EXPECT_EQ (wide_list[24], 12);
+  std::array<std::uint8_t, 32> wide_out;
+  EXPECT_EQ (rlp_encode_into (wide_out, wide), 25);
+  EXPECT_TRUE (std::equal (wide_list.begin (), wide_list.end (),
+                           wide_out.begin ()));
+
+  std::array<std::uint8_t, 16> out;
+  std::vector<std::string> words = { "cat", "dog" };
+  std::size_t n = rlp_encode_into (out, words);
+  EXPECT_EQ (n, rlp_length (words));
+  EXPECT_EQ (n, 9);
+  EXPECT_EQ (out[0], 0xc8);
+  std::array<std::uint8_t, 4> small;
+  EXPECT_THROW (rlp_encode_into (small, words), std::length_error);
+}
+
+TEST (RlpTest, ReverseWriter)
+{
+  std::vector<std::vector<unsigned> > nested = { {}, { 1 }, { 2, 3 } };
+  rlp_buffer<std::uint8_t> forward;
+  forward.putl (nested);
+
+  rlp_reverse_writer<std::uint8_t> writer (2);
+  std::size_t outer = writer.mark ();
+  writer.putl (nested[2]).putl (nested[1]);
+  std::size_t inner = writer.mark ();
+  writer.list (inner).list (outer);
+  EXPECT_TRUE (std::ranges::equal (writer, forward));
+  EXPECT_THROW (writer.list (writer.size () + 1), std::out_of_range);
+  EXPECT_EQ (writer.size (), forward.size ());
+
+  writer.clear ();
+  std::vector<std::string> words (40, "0123456789");
+  writer.putl (words);
+  rlp_buffer<std::uint8_t> expected;
+  expected.putl (words);
+  EXPECT_TRUE (std::ranges::equal (writer, expected));
+
+  rlp_buffer<std::uint8_t> joined;
+  joined.concat (writer);
+  EXPECT_EQ (joined.size (), writer.size ());
+}
+
+TEST (RlpTest, WideIntegerEncoding)
+{
+  uint256 max = ~uint256 (0);
+  rlp_buffer<std::uint8_t> buffer;
+  buffer.put (max).put (uint160 (1) << 152).put (~std::uint64_t (0));
+  ASSERT_EQ (buffer.size (), 33 + 21 + 9);
+  EXPECT_EQ (buffer[0], 0xa0);
+  EXPECT_TRUE (std::all_of (buffer.begin () + 1, buffer.begin () + 33,
+                            [] (std::uint8_t c) { return c == 0xff; }));
+  EXPECT_EQ (buffer[33], 0x94);
+  EXPECT_EQ (buffer[34], 0x01);
+  EXPECT_EQ (buffer[54], 0x88);
+  EXPECT_EQ (rlp_length (max), 33);
+  EXPECT_EQ (rlp_length (uint128 (0x80)), 2);
+}
+
+TEST (RlpTest, CanonicalIntegerDecoding)
+{
+  uint256 value = (uint256 (0xdeadbeef) << 192) | 0x1234;
+  rlp_buffer<std::uint8_t> buffer;
+  buffer.put (value);
+  rlp_item<const std::uint8_t> item (buffer.data (), buffer.size ());
+  EXPECT_EQ (item.to_value<uint256> (), value);
+  EXPECT_EQ (item.to_value<uint512> (), uint512 (value));
+  EXPECT_EQ (item.to_value<bigint> (), bigint (value));
+  EXPECT_THROW (item.to_value<uint128> (), std::bad_cast);
+  EXPECT_THROW (item.to_value<std::uint64_t> (), std::bad_cast);
+
+  auto decode = [] (std::vector<std::uint8_t> bytes) {
+    rlp_item<const std::uint8_t> item (bytes.data (), bytes.size ());
+    return item.to_value<std::uint64_t> ();
+  };
+  EXPECT_EQ (decode ({ 0x80 }), 0);
+  EXPECT_EQ (decode ({ 0x7f }), 0x7f);
+  EXPECT_EQ (decode ({ 0x82, 0x04, 0x00 }), 0x400);
+  EXPECT_THROW (decode ({ 0x00 }), std::bad_cast);
+  EXPECT_THROW (decode ({ 0x82, 0x00, 0x04 }), std::bad_cast);
+  EXPECT_THROW (decode ({ 0x81, 0x05 }), std::bad_cast);
+
+  // A single byte item followed by more bytes in its span.
+  EXPECT_EQ (decode ({ 0x05, 0x81, 0x80 }), 5);
+  EXPECT_THROW (decode ({ 0x81, 0x05, 0x06 }), std::bad_cast);
+}
+
+TEST (RlpTest, Validate)
+{
+  auto validate = [] (std::vector<std::uint8_t> bytes,
+                      std::size_t depth = rlp_default_max_depth) {
+    return rlp_validate (as_byte_view (bytes), depth);
+  };
+
+  rlp_buffer<std::uint8_t> buffer;
+  std::vector<std::vector<std::string> > nested
+      = { { "cat", "dog" }, {}, { std::string (60, 'x') } };
+  buffer.putl (nested).put (1024u);
+  rlp_validate_result ok = rlp_validate (as_byte_view (buffer));
+  EXPECT_TRUE (ok);
+  EXPECT_EQ (ok.offset, buffer.size ());
+
+  EXPECT_EQ (validate ({ 0x83, 'd', 'o' }).ec, rlp_errc::truncated);
+  EXPECT_EQ (validate ({ 0xc2, 0x83, 'd', 'o', 'g' }).ec, rlp_errc::overrun);
+  EXPECT_EQ (validate ({ 0x81, 0x05 }).ec,
+             rlp_errc::non_canonical_single_byte);
+  EXPECT_EQ (validate ({ 0xb8, 0x02, 'h', 'i' }).ec,
+             rlp_errc::non_canonical_size);
+  EXPECT_TRUE (validate ({ 0xc1, 0xc0 }, 2));
+  EXPECT_EQ (validate ({ 0xc1, 0xc0 }, 1).ec, rlp_errc::depth_exceeded);
+
+  rlp_validate_result bad = validate ({ 0x01, 0xc3, 0x01, 0x81, 0x02 });
+  EXPECT_FALSE (bad);
+  EXPECT_EQ (bad.offset, 3);
+  EXPECT_EQ (bad.ec.category (), rlp_category ());
+}
+
+TEST (RlpTest, SchemaDecode)
+{
+  std::vector<std::uint8_t> to (20, 0x35);
+  rlp_buffer<std::uint8_t> fields;
+  fields.put (9u).put (uint256 (20000000000ull)).put (21000u).put (to);
+  fields.put (uint256 (1000000000000000000ull)).put ("");
+  const std::vector<std::uint8_t> payload (fields.begin (), fields.end ());
+  rlp_buffer<std::uint8_t> buffer;
+  buffer.putl (payload);
+
+  legacy_tx tx{};
+  EXPECT_FALSE (rlp_decode (as_byte_view (buffer), tx));
+  EXPECT_EQ (tx.nonce, 9);
+  EXPECT_EQ (tx.gas_price, 20000000000ull);
+  EXPECT_EQ (tx.gas, 21000);
+  EXPECT_EQ (tx.to.size (), 20);
+  EXPECT_EQ ((const void *)tx.to.data (), (const void *)(buffer.data () + 12));
+  EXPECT_EQ (tx.value, 1000000000000000000ull);
+  EXPECT_TRUE (tx.data.empty ());
+
+  std::vector<std::uint8_t> bytes (buffer.begin (), buffer.end ());
+  bytes.push_back (0x00);
+  EXPECT_EQ (rlp_decode (as_byte_view (bytes), tx), rlp_errc::trailing_bytes);
+  auto decode = [&tx] (std::vector<std::uint8_t> bytes) {
+    return rlp_decode (as_byte_view (bytes), tx);
+  };
+  EXPECT_EQ (decode ({ 0xc2, 0x01, 0x02 }), rlp_errc::field_count_mismatch);
+  EXPECT_EQ (decode ({ 0xc1, 0xc0 }), rlp_errc::unexpected_type);
+  EXPECT_EQ (decode ({ 0x83, 0x01 }), rlp_errc::truncated);
+
+  tagged t{};
+  const std::vector<std::uint8_t> exact = { 0xc5, 0x84, 1, 2, 3, 4 };
+  EXPECT_FALSE (rlp_decode (as_byte_view (exact), t));
+  EXPECT_EQ (t.tag[3], 4);
+  const std::vector<std::uint8_t> short_tag = { 0xc4, 0x83, 1, 2, 3 };
+  EXPECT_EQ (rlp_decode (as_byte_view (short_tag), t),
+             rlp_errc::length_mismatch);
+}
+
+TEST (RlpTest, SchemaEncode)
+{
+  std::vector<std::uint8_t> to (20, 0x35);
+  legacy_tx tx{ 9,  uint256 (20000000000ull), 21000, as_byte_view (to),
+                uint256 (1000000000000000000ull), byte_view () };
+  rlp_buffer<std::uint8_t> buffer;
+  buffer.put (tx);
+  EXPECT_EQ (buffer.size (), rlp_length (tx));
+
+  legacy_tx decoded{};
+  EXPECT_FALSE (rlp_decode (as_byte_view (buffer), decoded));
+  EXPECT_EQ (decoded.nonce, tx.nonce);
+  EXPECT_EQ (decoded.gas_price, tx.gas_price);
+  EXPECT_EQ (decoded.gas, tx.gas);
+  EXPECT_TRUE (std::equal (decoded.to.begin (), decoded.to.end (),
+                           tx.to.begin (), tx.to.end ()));
+  EXPECT_EQ (decoded.value, tx.value);
+  EXPECT_TRUE (decoded.data.empty ());
+
+  // Described structs nested in a list are sized in the same pass.
+  std::vector<legacy_tx> block = { tx, tx, tx };
+  rlp_buffer<std::uint8_t> txs;
+  txs.put (block);
+  std::size_t tx_length = buffer.size ();
+  ASSERT_EQ (txs.size (), rlp_length (block));
+  rlp_item<const std::uint8_t> list (txs.data (), txs.size ());
+  ASSERT_EQ (list.items_size (), 3);
+  EXPECT_TRUE (std::equal (buffer.begin (), buffer.end (),
+                           txs.end () - tx_length, txs.end ()));
+
+  static_assert (!rlp_bounded<legacy_tx>);
+  static_assert (rlp_max_length_v<std::uint64_t> == 9);
+  static_assert (rlp_max_length_v<uint256> == 33);
+  static_assert (rlp_max_length_v<std::array<std::uint8_t, 20> > == 21);
+  std::array<std::uint8_t, rlp_max_length_v<std::array<uint256, 2> > > stack;
+  std::array<uint256, 2> values = { ~uint256 (0), ~uint256 (0) };
+  EXPECT_EQ (rlp_encode_into (stack, values), stack.size ());
+
+  // Bounded messages can be staged without touching the heap.
+  static_buffer<stack.size (), std::uint8_t> storage;
+  basic_buffer staged (storage);
+  auto view = staged.prepare (rlp_length (values));
+  staged.commit (rlp_encode_into (view, values));
+  EXPECT_TRUE (std::equal (staged.begin (), staged.end (), stack.begin (),
+                           stack.end ()));
+}
+
+TEST (RlpTest, PmrBuffer)
+{
+  std::array<std::byte, 1024> arena;
+  std::pmr::monotonic_buffer_resource resource (
+      arena.data (), arena.size (), std::pmr::null_memory_resource ());
+  pmr::rlp_buffer<std::uint8_t> buffer (&resource);
+  buffer.reserve (256);
+  buffer.putl (std::vector<std::string>{ "cat", "dog" }).put (1024u);
+  EXPECT_EQ (buffer.get_allocator ().resource (), &resource);
+
+  // Sizing lists nested past the inline slots draws from the buffer's
+  // resource too.
+  std::vector<std::vector<unsigned> > wide (12, { 1 });
+  counting_resource counting;
+  pmr::rlp_buffer<std::uint8_t> deep (&counting);
+  deep.reserve (64);
+  std::size_t reserved = counting.allocations;
+  deep.put (wide);
+  EXPECT_GT (counting.allocations, reserved);
+  EXPECT_EQ (deep.size (), rlp_length (wide));
+
+  rlp_buffer<std::uint8_t> expected;
+  expected.putl (std::vector<std::string>{ "cat", "dog" }).put (1024u);
+  EXPECT_TRUE (std::equal (buffer.begin (), buffer.end (), expected.begin (),
+                           expected.end ()));
+
+  std::istringstream input ("1 2 300");
+  pmr::rlp_buffer<std::uint8_t> streamed (&resource);
+  streamed.putl (std::views::istream<unsigned> (input));
+  rlp_buffer<std::uint8_t> listed;
+  listed.putl (std::vector<unsigned>{ 1, 2, 300 });
+  EXPECT_TRUE (std::equal (streamed.begin (), streamed.end (),
+                           listed.begin (), listed.end ()));
+
+  // A throwing element leaves the buffer as it was.
+  std::istringstream bad_hex ("0x12 0x34 0xzz");
+  std::size_t before = streamed.size ();
+  EXPECT_THROW (streamed.putl (std::views::istream<std::string> (bad_hex)),
+                std::invalid_argument);
+  EXPECT_EQ (streamed.size (), before);
+}
@@ -0,0 +1,51 @@
+#include "buffer.h"
+#include "rlp.h"
+#include "small_bytes.h"
+#include <gtest/gtest.h>
+
+using namespace basic;
+
+TEST (SmallBytesTest, InlineAndHeap)
+{
+  static_assert (basic_buffer_underlying<small_bytes<32> >);
+  small_bytes<32> address (20, byte{ 0x35 });
+  EXPECT_TRUE (address.is_inline ());
+  EXPECT_EQ (address.capacity (), 32);
+  EXPECT_EQ (as_byte_view (address).size (), 20);
+
+  small_bytes<32> copy = address;
+  copy.resize (100);
+  EXPECT_FALSE (copy.is_inline ());
+  EXPECT_EQ (copy[19], byte{ 0x35 });
+  EXPECT_EQ (copy[20], byte{ 0 });
+
+  small_bytes<32> moved = std::move (copy);
+  EXPECT_EQ (moved.size (), 100);
+  EXPECT_TRUE (copy.empty ());
+  EXPECT_TRUE (copy.is_inline ());
+
+  moved.erase (moved.begin (), moved.begin () + 90);
+  EXPECT_EQ (moved.size (), 10);
+  EXPECT_EQ (moved[0], byte{ 0 });
+}
+
+TEST (SmallBytesTest, RlpAndBuffer)
+{
+  small_bytes<32, std::uint8_t> hash (32, 0xab);
+  rlp_buffer<std::uint8_t> encoded;
+  encoded.put (hash);
+  EXPECT_EQ (encoded.size (), 33);
+  EXPECT_EQ (encoded[0], 0xa0);
+
+  rlp_item<const std::uint8_t> item (encoded.data (), encoded.size ());
+  auto decoded = item.to_value<small_bytes<32, std::uint8_t> > ();
+  EXPECT_TRUE (decoded == hash);
+
+  small_bytes<64> storage;
+  basic_buffer buffer (storage);
+  buffer.prepare (16);
+  buffer.commit (16);
+  buffer.consume (4);
+  EXPECT_EQ (buffer.size (), 12);
+  EXPECT_TRUE (storage.is_inline ());
+}